@@ -21,30 +21,50 @@
 #include "agg_file.h"
 
 #include <cctype>
+#include <cstddef>
 #include <cstdint>
 #include <iterator>
 #include <string>
+#include <utility>
 
 namespace fheroes2
 {
     bool AGGFile::open( const std::string & fileName )
     {
-        if ( !_stream.open( fileName, "rb" ) ) {
+        _files.clear();
+
+        if ( !_file.open( fileName ) ) {
+            return false;
+        }
+
+        const size_t size = _file.size();
+        if ( size < sizeof( uint16_t ) ) {
+            return false;
+        }
+
+        const FileData header = _file.read( 0, sizeof( uint16_t ) );
+        if ( header.size() != sizeof( uint16_t ) ) {
             return false;
         }
 
-        const size_t size = _stream.size();
-        const size_t count = _stream.getLE16();
+        ROStreamBuf stream( header.data(), header.size() );
+
+        const size_t count = stream.getLE16();
         const size_t fileRecordSize = sizeof( uint32_t ) * 3;
 
-        if ( count * ( fileRecordSize + _maxFilenameSize ) >= size ) {
+        if ( count == 0 || count * ( fileRecordSize + _maxFilenameSize ) >= size ) {
             return false;
         }
 
-        ROStreamBuf fileEntries = _stream.getStreamBuf( count * fileRecordSize );
+        const FileData fileEntriesData = _file.read( sizeof( uint16_t ), count * fileRecordSize );
         const size_t nameEntriesSize = _maxFilenameSize * count;
-        _stream.seek( size - nameEntriesSize );
-        ROStreamBuf nameEntries = _stream.getStreamBuf( nameEntriesSize );
+        const FileData nameEntriesData = _file.read( size - nameEntriesSize, nameEntriesSize );
+        if ( fileEntriesData.size() == 0 || nameEntriesData.size() == 0 ) {
+            return false;
+        }
+
+        ROStreamBuf fileEntries( fileEntriesData.data(), fileEntriesData.size() );
+        ROStreamBuf nameEntries( nameEntriesData.data(), nameEntriesData.size() );
 
         for ( size_t i = 0; i < count; ++i ) {
             std::string name = nameEntries.getString( _maxFilenameSize );
@@ -58,6 +78,13 @@ namespace fheroes2
 
             const uint32_t fileOffset = fileEntries.getLE32();
             const uint32_t fileSize = fileEntries.getLE32();
+
+            if ( static_cast<size_t>( fileOffset ) + fileSize > size ) {
+                // The file is outside of the AGG file. AGG file is corrupted.
+                _files.clear();
+                return false;
+            }
+
             _files.try_emplace( std::move( name ), std::make_pair( fileSize, fileOffset ) );
         }
 
@@ -66,10 +93,20 @@ namespace fheroes2
             return false;
         }
 
-        return !_stream.fail();
+        return true;
+    }
+
+    std::vector<uint8_t> AGGFile::read( const std::string & fileName ) const
+    {
+        const FileData fileData = getData( fileName );
+        if ( fileData.size() == 0 ) {
+            return {};
+        }
+
+        return { fileData.data(), fileData.data() + fileData.size() };
     }
 
-    std::vector<uint8_t> AGGFile::read( const std::string & fileName )
+    FileData AGGFile::getData( const std::string & fileName ) const
     {
         auto it = _files.find( fileName );
         if ( it == _files.end() ) {
@@ -77,12 +114,7 @@ namespace fheroes2
         }
 
         const auto [fileSize, fileOffset] = it->second;
-        if ( fileSize > 0 ) {
-            _stream.seek( fileOffset );
-            return _stream.getRaw( fileSize );
-        }
-
-        return {};
+        return _file.read( fileOffset, fileSize );
     }
 
     uint32_t calculateAggFilenameHash( const std::string_view str )
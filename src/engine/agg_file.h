@@ -29,25 +29,34 @@
 #include <utility>
 #include <vector>
 
+#include "memory_mapped_file.h"
 #include "serialize.h"
 
 namespace fheroes2
 {
+    // AGG file content is accessed through memory mapping or read on demand on platforms without memory mapping support.
+    // All methods except open() do not change the object so the data can be accessed from multiple threads at the same time.
     class AGGFile final
     {
     public:
         bool isGood() const
         {
-            return !_stream.fail() && !_files.empty();
+            return _file.isOpen() && !_files.empty();
         }
 
         bool open( const std::string & fileName );
-        std::vector<uint8_t> read( const std::string & fileName );
+
+        // Returns a copy of the requested file data or an empty vector if the file does not exist.
+        std::vector<uint8_t> read( const std::string & fileName ) const;
+
+        // Returns the requested file data or empty data if the file does not exist. The data is not copied on platforms supporting
+        // memory mapping, in this case it is valid as long as this object is open.
+        FileData getData( const std::string & fileName ) const;
 
     private:
         static const size_t _maxFilenameSize = 15; // 8.3 ASCIIZ file name + 2-bytes padding
 
-        StreamFile _stream;
+        MemoryMappedFile _file;
         std::map<std::string, std::pair<uint32_t, uint32_t>, std::less<>> _files;
     };
 
@@ -27,6 +27,7 @@
 #include <atomic>
 #include <cassert>
 #include <cmath>
+#include <cstring>
 #include <list>
 #include <map>
 #include <memory>
@@ -49,6 +50,7 @@
 #include <SDL_mixer.h>
 #include <SDL_rwops.h>
 #include <SDL_stdinc.h>
+#include <SDL_version.h>
 
 // Managing compiler warnings for SDL headers
 #if defined( __GNUC__ )
@@ -62,6 +64,20 @@
 #include "thread.h"
 #include "timing.h"
 
+#if SDL_VERSION_ATLEAST( 2, 0, 7 )
+struct Mixer::AudioStreamState
+{
+    std::unique_ptr<SDL_AudioStream, void ( * )( SDL_AudioStream * )> stream{ nullptr, SDL_FreeAudioStream };
+    // This mutex protects the stream which is filled by the main thread and read by a SDL_Mixer internal thread.
+    std::mutex streamMutex;
+
+    uint8_t silence{ 0 };
+
+    int channelId{ -1 };
+    std::atomic<bool> isPlaying{ false };
+};
+#endif
+
 namespace
 {
     struct AudioSpec
@@ -208,6 +224,39 @@ namespace
         soundSampleManager.channelFinished( channelId );
     }
 
+#if SDL_VERSION_ATLEAST( 2, 0, 7 )
+    // This is the callback function set by Mix_RegisterEffect() for audio streams. As a rule, it is called from a SDL_Mixer internal thread.
+    // It replaces the silent sample being played by the channel with the data of the audio stream.
+    void SDLCALL audioStreamEffect( const int /* channelId */, void * buffer, const int size, void * userData )
+    {
+        Mixer::AudioStreamState & state = **static_cast<std::shared_ptr<Mixer::AudioStreamState> *>( userData );
+
+        int receivedSize = 0;
+
+        {
+            const std::scoped_lock<std::mutex> lock( state.streamMutex );
+
+            receivedSize = std::max( SDL_AudioStreamGet( state.stream.get(), buffer, size ), 0 );
+        }
+
+        // Either the data has not been passed to the stream in time or the stream is over.
+        if ( receivedSize < size ) {
+            memset( static_cast<uint8_t *>( buffer ) + receivedSize, state.silence, static_cast<size_t>( size - receivedSize ) );
+        }
+    }
+
+    // This is the callback function set by Mix_RegisterEffect() for audio streams. It is called when the channel stops playing,
+    // either from a SDL_Mixer internal thread or from the thread which halts the channel. No SDL_Mixer functions are called here.
+    void SDLCALL audioStreamEffectDone( const int /* channelId */, void * userData )
+    {
+        std::shared_ptr<Mixer::AudioStreamState> * state = static_cast<std::shared_ptr<Mixer::AudioStreamState> *>( userData );
+
+        ( *state )->isPlaying = false;
+
+        delete state;
+    }
+#endif
+
     class MusicInfo
     {
     public:
@@ -946,6 +995,142 @@ bool Mixer::isPlaying( const int channelId )
     return isInitialized && Mix_Playing( channelId ) > 0;
 }
 
+bool Mixer::AudioStream::start( const uint32_t sampleRate, const uint8_t bitsPerSample, const uint8_t channelCount, const uint32_t durationMs )
+{
+    stop();
+
+#if SDL_VERSION_ATLEAST( 2, 0, 7 )
+    if ( sampleRate == 0 || ( bitsPerSample != 8 && bitsPerSample != 16 ) || channelCount == 0 ) {
+        return false;
+    }
+
+    const std::scoped_lock<std::recursive_mutex> lock( audioMutex );
+
+    if ( !isInitialized ) {
+        return false;
+    }
+
+    soundSampleManager.clearFinishedSamples();
+
+    int frequency = 0;
+    uint16_t format = 0;
+    int channels = 0;
+
+    if ( Mix_QuerySpec( &frequency, &format, &channels ) == 0 ) {
+        ERROR_LOG( "Failed to query an audio device specs. The error: " << Mix_GetError() )
+        return false;
+    }
+
+    auto state = std::make_shared<AudioStreamState>();
+
+    state->stream.reset( SDL_NewAudioStream( bitsPerSample == 8 ? AUDIO_U8 : AUDIO_S16LSB, channelCount, static_cast<int>( sampleRate ), format,
+                                             static_cast<uint8_t>( channels ), frequency ) );
+    if ( !state->stream ) {
+        ERROR_LOG( "Failed to create an audio stream. The error: " << SDL_GetError() )
+        return false;
+    }
+
+    state->silence = ( format == AUDIO_U8 ) ? 0x80 : 0x00;
+
+    // The stream data is mixed by the effect registered for a channel which plays a looped silent sample of one second long.
+    const uint32_t silentSampleSize = static_cast<uint32_t>( SDL_AUDIO_BITSIZE( format ) / 8 * channels * frequency );
+
+    uint8_t * silentSampleData = static_cast<uint8_t *>( SDL_malloc( silentSampleSize ) );
+    if ( silentSampleData == nullptr ) {
+        ERROR_LOG( "Failed to allocate memory for an audio stream." )
+        return false;
+    }
+
+    memset( silentSampleData, state->silence, silentSampleSize );
+
+    std::unique_ptr<Mix_Chunk, void ( * )( Mix_Chunk * )> sample( Mix_QuickLoad_RAW( silentSampleData, silentSampleSize ), Mix_FreeChunk );
+    if ( !sample ) {
+        ERROR_LOG( "Failed to create an audio chunk for an audio stream. The error: " << Mix_GetError() )
+        SDL_free( silentSampleData );
+        return false;
+    }
+
+    // The sample data must be freed together with the sample.
+    sample->allocated = 1;
+
+    // The sample is played one more time than the number of loops, so the playback lasts not less than the given duration.
+    const int channelId = Mix_PlayChannel( -1, sample.get(), static_cast<int>( durationMs / 1000 ) );
+    if ( channelId < 0 ) {
+        ERROR_LOG( "Failed to play the audio chunk. The error: " << Mix_GetError() )
+        return false;
+    }
+
+    soundSampleManager.channelStarted( channelId, sample.release() );
+
+    state->channelId = channelId;
+    state->isPlaying = true;
+
+    // The effect shares the ownership of the state, which is released when the channel stops playing.
+    auto * effectState = new std::shared_ptr<AudioStreamState>( state );
+
+    if ( Mix_RegisterEffect( channelId, audioStreamEffect, audioStreamEffectDone, effectState ) == 0 ) {
+        ERROR_LOG( "Failed to register an effect for channel " << channelId << ". The error: " << Mix_GetError() )
+
+        delete effectState;
+
+        Mix_HaltChannel( channelId );
+
+        return false;
+    }
+
+    _state = std::move( state );
+
+    return true;
+#else
+    static_cast<void>( sampleRate );
+    static_cast<void>( bitsPerSample );
+    static_cast<void>( channelCount );
+    static_cast<void>( durationMs );
+
+    // Audio streams are not supported by this version of SDL.
+    return false;
+#endif
+}
+
+void Mixer::AudioStream::put( const uint8_t * data, const size_t size )
+{
+#if SDL_VERSION_ATLEAST( 2, 0, 7 )
+    if ( !_state || size == 0 ) {
+        return;
+    }
+
+    const std::scoped_lock<std::mutex> lock( _state->streamMutex );
+
+    if ( SDL_AudioStreamPut( _state->stream.get(), data, static_cast<int>( size ) ) != 0 ) {
+        ERROR_LOG( "Failed to put data into an audio stream. The error: " << SDL_GetError() )
+    }
+#else
+    static_cast<void>( data );
+    static_cast<void>( size );
+#endif
+}
+
+void Mixer::AudioStream::stop()
+{
+#if SDL_VERSION_ATLEAST( 2, 0, 7 )
+    if ( !_state ) {
+        return;
+    }
+
+    {
+        const std::scoped_lock<std::recursive_mutex> lock( audioMutex );
+
+        // The channel could not be used by any other sound while the stream is being played, and a new sound can be started
+        // only by the thread which holds the mutex, so the channel can be safely halted.
+        if ( isInitialized && _state->isPlaying && Mix_HaltChannel( _state->channelId ) != 0 ) {
+            ERROR_LOG( "Failed to halt channel " << _state->channelId << ". The error: " << Mix_GetError() )
+        }
+    }
+
+    _state.reset();
+#endif
+}
+
 bool Music::Play( const uint64_t musicUID, const PlaybackMode playbackMode )
 {
     const std::scoped_lock<std::recursive_mutex> lock( audioMutex );
@@ -23,7 +23,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <utility>
@@ -64,6 +66,35 @@ namespace Mixer
     void Stop( const int channelId = -1 );
 
     bool isPlaying( const int channelId );
+
+    struct AudioStreamState;
+
+    // Plays audio which is passed to the mixer by portions while it is being played, e.g. the audio track of a video which is decoded
+    // frame by frame. The playback stops either when the given duration has passed or when the stream is stopped. Destruction of
+    // this object does not stop the playback, so the data which has been already passed is played till the end.
+    class AudioStream final
+    {
+    public:
+        AudioStream() = default;
+        AudioStream( const AudioStream & ) = delete;
+        AudioStream( AudioStream && ) = default;
+
+        ~AudioStream() = default;
+
+        AudioStream & operator=( const AudioStream & ) = delete;
+        AudioStream & operator=( AudioStream && ) = delete;
+
+        // Starts the playback of PCM audio with the given parameters. 8-bit samples are unsigned and 16-bit samples are signed
+        // little-endian. Returns false if the streaming playback is not supported or it has failed to start.
+        bool start( const uint32_t sampleRate, const uint8_t bitsPerSample, const uint8_t channelCount, const uint32_t durationMs );
+
+        void put( const uint8_t * data, const size_t size );
+
+        void stop();
+
+    private:
+        std::shared_ptr<AudioStreamState> _state;
+    };
 }
 
 namespace Music
@@ -182,6 +182,13 @@ namespace System
         }
     }
 
+    CoreInitializer::CoreInitializer( const std::set<SystemInitializationComponent> & components )
+    {
+        if ( !initCoreInternally( components ) ) {
+            throw std::logic_error( "Core module initialization failed." );
+        }
+    }
+
     CoreInitializer::~CoreInitializer()
     {
         freeCoreInternally();
@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <set>
+
 #include "component_base.h"
 
 namespace System
@@ -45,6 +47,8 @@ namespace System
     {
     public:
         explicit CoreInitializer();
+        // Initializes only the requested components. An empty set is used for headless runs without any window or audio device.
+        explicit CoreInitializer( const std::set<SystemInitializationComponent> & components );
         CoreInitializer( const CoreInitializer & ) = delete;
         CoreInitializer & operator=( const CoreInitializer & ) = delete;
 
@@ -0,0 +1,248 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "fast_lz.h"
+
+#include <cassert>
+#include <cstring>
+
+namespace
+{
+    const size_t minMatchLength{ 4 };
+
+    const size_t maxMatchOffset{ 65535 };
+
+    // The block format requires the last bytes of the data to be stored as literals.
+    const size_t lastLiteralsLength{ 5 };
+
+    // A match cannot start closer than this to the end of the data.
+    const size_t matchStartLimit{ 12 };
+
+    const uint32_t hashTableBits{ 14 };
+
+    // Values of literal and match lengths which require additional bytes to be stored.
+    const size_t extendedLengthMarker{ 15 };
+
+    uint32_t read32( const uint8_t * data )
+    {
+        uint32_t value;
+        memcpy( &value, data, sizeof( value ) );
+        return value;
+    }
+
+    uint32_t getHash( const uint32_t sequence )
+    {
+        return ( sequence * 2654435761U ) >> ( 32 - hashTableBits );
+    }
+
+    void writeExtendedLength( size_t length, std::vector<uint8_t> & output )
+    {
+        while ( length >= 255 ) {
+            output.push_back( 255 );
+            length -= 255;
+        }
+
+        output.push_back( static_cast<uint8_t>( length ) );
+    }
+
+    // Reads the remaining part of the length. Returns false if the data ends before the length is fully read.
+    bool readExtendedLength( const uint8_t * src, const size_t srcSize, size_t & srcPos, size_t & length )
+    {
+        uint8_t value = 255;
+
+        while ( value == 255 ) {
+            if ( srcPos >= srcSize ) {
+                return false;
+            }
+
+            value = src[srcPos];
+            ++srcPos;
+
+            length += value;
+        }
+
+        return true;
+    }
+
+    void writeSequence( const uint8_t * literals, const size_t literalsLength, const size_t matchOffset, const size_t matchLength, std::vector<uint8_t> & output )
+    {
+        const size_t tokenPos = output.size();
+        output.push_back( 0 );
+
+        uint8_t token = 0;
+
+        if ( literalsLength >= extendedLengthMarker ) {
+            token = static_cast<uint8_t>( extendedLengthMarker << 4 );
+            writeExtendedLength( literalsLength - extendedLengthMarker, output );
+        }
+        else {
+            token = static_cast<uint8_t>( literalsLength << 4 );
+        }
+
+        output.insert( output.end(), literals, literals + literalsLength );
+
+        if ( matchLength > 0 ) {
+            assert( matchLength >= minMatchLength && matchOffset > 0 && matchOffset <= maxMatchOffset );
+
+            output.push_back( static_cast<uint8_t>( matchOffset & 0xFF ) );
+            output.push_back( static_cast<uint8_t>( matchOffset >> 8 ) );
+
+            const size_t storedMatchLength = matchLength - minMatchLength;
+            if ( storedMatchLength >= extendedLengthMarker ) {
+                token |= static_cast<uint8_t>( extendedLengthMarker );
+                writeExtendedLength( storedMatchLength - extendedLengthMarker, output );
+            }
+            else {
+                token |= static_cast<uint8_t>( storedMatchLength );
+            }
+        }
+
+        output[tokenPos] = token;
+    }
+}
+
+void Compression::fastZipBlock( const uint8_t * src, const size_t srcSize, std::vector<uint8_t> & output )
+{
+    // The worst case is when the data cannot be zipped at all.
+    output.reserve( output.size() + srcSize + srcSize / 255 + 16 );
+
+    size_t anchor = 0;
+
+    if ( srcSize > matchStartLimit ) {
+        std::vector<uint32_t> hashTable( static_cast<size_t>( 1 ) << hashTableBits, 0 );
+
+        const size_t matchEndLimit = srcSize - lastLiteralsLength;
+        const size_t lastMatchStart = srcSize - matchStartLimit;
+
+        size_t pos = 0;
+
+        while ( pos <= lastMatchStart ) {
+            const uint32_t sequence = read32( src + pos );
+            const uint32_t hash = getHash( sequence );
+
+            size_t matchPos = hashTable[hash];
+            hashTable[hash] = static_cast<uint32_t>( pos );
+
+            if ( matchPos >= pos || pos - matchPos > maxMatchOffset || read32( src + matchPos ) != sequence ) {
+                // Skip faster over the data which cannot be zipped.
+                pos += 1 + ( ( pos - anchor ) >> 6 );
+                continue;
+            }
+
+            // Extend the match backwards over the pending literals.
+            while ( pos > anchor && matchPos > 0 && src[pos - 1] == src[matchPos - 1] ) {
+                --pos;
+                --matchPos;
+            }
+
+            size_t matchLength = minMatchLength;
+            while ( pos + matchLength < matchEndLimit && src[matchPos + matchLength] == src[pos + matchLength] ) {
+                ++matchLength;
+            }
+
+            writeSequence( src + anchor, pos - anchor, pos - matchPos, matchLength, output );
+
+            pos += matchLength;
+            anchor = pos;
+
+            if ( pos <= lastMatchStart ) {
+                hashTable[getHash( read32( src + pos - 2 ) )] = static_cast<uint32_t>( pos - 2 );
+            }
+        }
+    }
+
+    writeSequence( src + anchor, srcSize - anchor, 0, 0, output );
+}
+
+bool Compression::fastUnzipBlock( const uint8_t * src, const size_t srcSize, uint8_t * dst, const size_t dstSize )
+{
+    if ( src == nullptr || srcSize == 0 || ( dst == nullptr && dstSize > 0 ) ) {
+        return false;
+    }
+
+    size_t srcPos = 0;
+    size_t dstPos = 0;
+
+    while ( true ) {
+        if ( srcPos >= srcSize ) {
+            return false;
+        }
+
+        const uint8_t token = src[srcPos];
+        ++srcPos;
+
+        size_t literalsLength = token >> 4;
+        if ( literalsLength == extendedLengthMarker && !readExtendedLength( src, srcSize, srcPos, literalsLength ) ) {
+            return false;
+        }
+
+        if ( literalsLength > srcSize - srcPos || literalsLength > dstSize - dstPos ) {
+            return false;
+        }
+
+        if ( literalsLength > 0 ) {
+            memcpy( dst + dstPos, src + srcPos, literalsLength );
+            srcPos += literalsLength;
+            dstPos += literalsLength;
+        }
+
+        if ( srcPos == srcSize ) {
+            // The last sequence contains only literals.
+            return dstPos == dstSize;
+        }
+
+        if ( srcSize - srcPos < 2 ) {
+            return false;
+        }
+
+        const size_t matchOffset = static_cast<size_t>( src[srcPos] ) | ( static_cast<size_t>( src[srcPos + 1] ) << 8 );
+        srcPos += 2;
+
+        if ( matchOffset == 0 || matchOffset > dstPos ) {
+            return false;
+        }
+
+        size_t matchLength = token & 0xF;
+        if ( matchLength == extendedLengthMarker && !readExtendedLength( src, srcSize, srcPos, matchLength ) ) {
+            return false;
+        }
+
+        matchLength += minMatchLength;
+
+        if ( matchLength > dstSize - dstPos ) {
+            return false;
+        }
+
+        uint8_t * out = dst + dstPos;
+        const uint8_t * match = out - matchOffset;
+
+        if ( matchOffset >= matchLength ) {
+            memcpy( out, match, matchLength );
+        }
+        else {
+            // The match overlaps the data being written, so it must be copied byte by byte.
+            for ( size_t i = 0; i < matchLength; ++i ) {
+                out[i] = match[i];
+            }
+        }
+
+        dstPos += matchLength;
+    }
+}
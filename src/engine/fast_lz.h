@@ -0,0 +1,36 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A fast LZ77 codec using the LZ4 block format. It zips and unzips data several times faster than zlib at the cost of a lower compression ratio.
+namespace Compression
+{
+    // Zips the data as a single block and appends the result to the end of the output buffer.
+    void fastZipBlock( const uint8_t * src, const size_t srcSize, std::vector<uint8_t> & output );
+
+    // Unzips a single block into the destination buffer which must have exactly the size of the original data. Returns true on success
+    // and false if the block is corrupted or its unzipped size does not match the size of the destination buffer.
+    bool fastUnzipBlock( const uint8_t * src, const size_t srcSize, uint8_t * dst, const size_t dstSize );
+}
@@ -26,6 +26,7 @@
 #include <cstring>
 
 #include "image.h"
+#include "serialize.h"
 #include "zzlib.h"
 
 namespace
@@ -46,33 +47,41 @@ namespace fheroes2
     bool H2DReader::open( const std::string & path )
     {
         _fileNameAndOffset.clear();
-        _fileStream.close();
 
-        if ( !_fileStream.open( path, "rb" ) ) {
+        if ( !_file.open( path ) ) {
             return false;
         }
 
-        const size_t fileSize = _fileStream.size();
+        const size_t fileSize = _file.size();
         if ( fileSize < minFileSize ) {
             return false;
         }
 
+        // The size of the file index is not known in advance so the whole file is accessed. On platforms without memory mapping support
+        // the file is read into memory only for the time of the index parsing.
+        const FileData fileData = _file.read( 0, fileSize );
+        if ( fileData.size() != fileSize ) {
+            return false;
+        }
+
+        ROStreamBuf fileStream( fileData.data(), fileData.size() );
+
         for ( const uint8_t value : magicSequence ) {
-            if ( _fileStream.get() != value ) {
+            if ( fileStream.get() != value ) {
                 return false;
             }
         }
 
-        const uint32_t fileCount = _fileStream.getLE32();
+        const uint32_t fileCount = fileStream.getLE32();
         if ( fileCount == 0 ) {
             return false;
         }
 
         for ( uint32_t i = 0; i < fileCount; ++i ) {
-            const uint32_t offset = _fileStream.getLE32();
-            const uint32_t size = _fileStream.getLE32();
+            const uint32_t offset = fileStream.getLE32();
+            const uint32_t size = fileStream.getLE32();
             std::string name;
-            _fileStream >> name;
+            fileStream >> name;
             if ( size == 0 || static_cast<size_t>( offset ) + size > fileSize || name.empty() ) {
                 continue;
             }
@@ -83,17 +92,16 @@ namespace fheroes2
         return true;
     }
 
-    std::vector<uint8_t> H2DReader::getFile( const std::string & fileName )
+    std::vector<uint8_t> H2DReader::getFile( const std::string & fileName ) const
     {
         const auto it = _fileNameAndOffset.find( fileName );
         if ( it == _fileNameAndOffset.end() ) {
             return {};
         }
 
-        _fileStream.seek( it->second.first );
-        const auto compressedData = _fileStream.getRaw( it->second.second );
-
-        return Compression::unzipData( compressedData.data(), compressedData.size() );
+        // The data is unpacked directly from the mapped file content when memory mapping is supported.
+        const FileData fileData = _file.read( it->second.first, it->second.second );
+        return Compression::unzipData( fileData.data(), fileData.size() );
     }
 
     std::set<std::string, std::less<>> H2DReader::getAllFileNames() const
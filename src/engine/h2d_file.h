@@ -28,7 +28,7 @@
 #include <utility>
 #include <vector>
 
-#include "serialize.h"
+#include "memory_mapped_file.h"
 
 namespace fheroes2
 {
@@ -41,8 +41,8 @@ namespace fheroes2
         // Returns true if file opening is successful.
         bool open( const std::string & path );
 
-        // Returns non-empty vector if requested file exists.
-        std::vector<uint8_t> getFile( const std::string & fileName );
+        // Returns non-empty vector if requested file exists. This method can be called from multiple threads at the same time.
+        std::vector<uint8_t> getFile( const std::string & fileName ) const;
 
         std::set<std::string, std::less<>> getAllFileNames() const;
 
@@ -50,8 +50,8 @@ namespace fheroes2
         // Relationship between file name in non-capital letters and its offset from the start of the archive.
         std::map<std::string, std::pair<uint32_t, uint32_t>, std::less<>> _fileNameAndOffset;
 
-        // Stream for reading h2d file.
-        StreamFile _fileStream;
+        // Content of h2d file.
+        MemoryMappedFile _file;
     };
 
     // This class is not designed to be performance optimized as it will be used very rarely and out of game running session.
@@ -28,6 +28,7 @@
 
 #include "exception.h"
 #include "image_color_conversion.h"
+#include "image_kernels.h"
 #include "image_palette.h"
 
 #if defined( GENERATE_COLOR_TABLE )
@@ -436,6 +437,28 @@ namespace
         return rgbToId[red + ( green << 6U ) + ( blue << 12U )];
     }
 
+    // Returns the number of consecutive bytes equal to the given value, starting from 'data' and going backward, but no more than 'maxLength'.
+    // Sprites have long runs of fully transparent or fully opaque pixels so 8 bytes are compared at once.
+    int32_t getBackwardRunLength( const uint8_t * data, const int32_t maxLength, const uint8_t value )
+    {
+        const uint64_t pattern = value * 0x0101010101010101ULL;
+
+        int32_t length = 0;
+
+        for ( uint64_t block = 0; length + 8 <= maxLength; length += 8 ) {
+            memcpy( &block, data - length - 7, sizeof( block ) );
+            if ( block != pattern ) {
+                break;
+            }
+        }
+
+        while ( length < maxLength && *( data - length ) == value ) {
+            ++length;
+        }
+
+        return length;
+    }
+
     void ApplyRawPalette( const fheroes2::Image & in, int32_t inX, int32_t inY, fheroes2::Image & out, int32_t outX, int32_t outY, int32_t width, int32_t height,
                           const uint8_t * palette )
     {
@@ -453,29 +476,51 @@ namespace
         if ( in.singleLayer() ) {
             // All pixels in a single-layer image do not have any transform values so there is no need to check for them.
             for ( ; imageInY != imageInYEnd; imageInY += widthIn, imageOutY += widthOut ) {
-                const uint8_t * imageInX = imageInY;
-                uint8_t * imageOutX = imageOutY;
-                const uint8_t * imageInXEnd = imageInX + width;
-
-                for ( ; imageInX != imageInXEnd; ++imageInX, ++imageOutX ) {
-                    *imageOutX = palette[*imageInX];
-                }
+                fheroes2::applyPaletteToRow( imageInY, imageOutY, width, palette );
             }
         }
         else {
             const uint8_t * transformInY = in.transform() + static_cast<ptrdiff_t>( inY ) * widthIn + inX;
 
             for ( ; imageInY != imageInYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut ) {
-                const uint8_t * imageInX = imageInY;
-                const uint8_t * transformInX = transformInY;
-                uint8_t * imageOutX = imageOutY;
-                const uint8_t * imageInXEnd = imageInX + width;
+                // Only modify pixels with data.
+                fheroes2::applyPaletteToMaskedRow( imageInY, transformInY, imageOutY, width, palette );
+            }
+        }
+    }
 
-                for ( ; imageInX != imageInXEnd; ++imageInX, ++imageOutX, ++transformInX ) {
-                    if ( *transformInX == 0 ) { // only modify pixels with data
-                        *imageOutX = palette[*imageInX];
-                    }
+    // Draws a row of a double-layer image mirrored: 'imageIn' and 'transformIn' point to the rightmost pixel of the input row.
+    // Runs of opaque pixels are copied at once and runs of transparent pixels are skipped at once. The transform layer of the output image is optional.
+    void blitFlippedRow( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, uint8_t * transformOut, const int32_t width )
+    {
+        int32_t x = 0;
+
+        while ( x < width ) {
+            const uint8_t transformValue = *( transformIn - x );
+
+            if ( transformValue == 0 ) { // copy pixels
+                const int32_t length = getBackwardRunLength( transformIn - x, width - x, 0 );
+
+                std::reverse_copy( imageIn - x - length + 1, imageIn - x + 1, imageOut + x );
+                if ( transformOut != nullptr ) {
+                    memset( transformOut + x, 0, static_cast<size_t>( length ) );
                 }
+
+                x += length;
+            }
+            else if ( transformValue == 1 ) { // skip pixels
+                x += getBackwardRunLength( transformIn - x, width - x, 1 );
+            }
+            else {
+                if ( transformOut == nullptr || transformOut[x] == 0 ) { // apply a transformation
+                    imageOut[x] = *( transformTable + static_cast<ptrdiff_t>( transformValue ) * fheroes2::paletteSize + imageOut[x] );
+                }
+                else { // copy a pixel
+                    transformOut[x] = transformValue;
+                    imageOut[x] = *( imageIn - x );
+                }
+
+                ++x;
             }
         }
     }
@@ -1178,31 +1223,19 @@ namespace fheroes2
         uint8_t * imageY = image.image() + y * imageWidth + x;
         const uint8_t * imageYEnd = imageY + height * imageWidth;
 
-        const uint32_t transformOffset = transformId * paletteSize;
+        const uint8_t * table = transformTable + transformId * paletteSize;
 
         if ( image.singleLayer() ) {
             for ( ; imageY != imageYEnd; imageY += imageWidth ) {
-                uint8_t * imageX = imageY;
-                const uint8_t * imageXEnd = imageX + width;
-
-                for ( ; imageX != imageXEnd; ++imageX ) {
-                    *imageX = *( transformTable + transformOffset + *imageX );
-                }
+                applyPaletteToRow( imageY, imageY, width, table );
             }
         }
         else {
             const uint8_t * transformY = image.transform() + y * imageWidth + x;
 
             for ( ; imageY != imageYEnd; imageY += imageWidth, transformY += imageWidth ) {
-                uint8_t * imageX = imageY;
-                const uint8_t * transformX = transformY;
-                const uint8_t * imageXEnd = imageX + width;
-
-                for ( ; imageX != imageXEnd; ++imageX, ++transformX ) {
-                    if ( *transformX == 0 ) {
-                        *imageX = *( transformTable + transformOffset + *imageX );
-                    }
-                }
+                // Only modify pixels with data.
+                applyPaletteToMaskedRow( imageY, transformY, imageY, width, table );
             }
         }
     }
@@ -1241,58 +1274,23 @@ namespace fheroes2
         const int32_t widthIn = in.width();
         const int32_t widthOut = out.width();
 
+        const int32_t offsetOutY = outY * widthOut + outX;
+        uint8_t * imageOutY = out.image() + offsetOutY;
+        uint8_t * transformOutY = out.singleLayer() ? nullptr : out.transform() + offsetOutY;
+        const uint8_t * imageOutYEnd = imageOutY + height * widthOut;
+
+        assert( !in.singleLayer() );
+
         if ( flip ) {
             const int32_t offsetInY = inY * widthIn + widthIn - 1 - inX;
             const uint8_t * imageInY = in.image() + offsetInY;
             const uint8_t * transformInY = in.transform() + offsetInY;
 
-            const int32_t offsetOutY = outY * widthOut + outX;
-            uint8_t * imageOutY = out.image() + offsetOutY;
-            const uint8_t * imageOutYEnd = imageOutY + height * widthOut;
-
-            if ( out.singleLayer() ) {
-                assert( !in.singleLayer() );
-                for ( ; imageOutY != imageOutYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut ) {
-                    const uint8_t * imageInX = imageInY;
-                    const uint8_t * transformInX = transformInY;
-                    uint8_t * imageOutX = imageOutY;
-                    const uint8_t * imageOutXEnd = imageOutX + width;
-
-                    for ( ; imageOutX != imageOutXEnd; --imageInX, --transformInX, ++imageOutX ) {
-                        if ( *transformInX > 0 ) { // apply a transformation
-                            if ( *transformInX != 1 ) { // skip pixel
-                                *imageOutX = *( transformTable + ( *transformInX ) * paletteSize + *imageOutX );
-                            }
-                        }
-                        else { // copy a pixel
-                            *imageOutX = *imageInX;
-                        }
-                    }
-                }
-            }
-            else {
-                uint8_t * transformOutY = out.transform() + offsetOutY;
-
-                for ( ; imageOutY != imageOutYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut, transformOutY += widthOut ) {
-                    const uint8_t * imageInX = imageInY;
-                    const uint8_t * transformInX = transformInY;
-                    uint8_t * imageOutX = imageOutY;
-                    uint8_t * transformOutX = transformOutY;
-                    const uint8_t * imageOutXEnd = imageOutX + width;
-
-                    for ( ; imageOutX != imageOutXEnd; --imageInX, --transformInX, ++imageOutX, ++transformOutX ) {
-                        if ( *transformInX == 1 ) { // skip pixel
-                            continue;
-                        }
+            for ( ; imageOutY != imageOutYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut ) {
+                blitFlippedRow( imageInY, transformInY, imageOutY, transformOutY, width );
 
-                        if ( *transformInX > 0 && *transformOutX == 0 ) { // apply a transformation
-                            *imageOutX = *( transformTable + ( *transformInX ) * paletteSize + *imageOutX );
-                        }
-                        else { // copy a pixel
-                            *transformOutX = *transformInX;
-                            *imageOutX = *imageInX;
-                        }
-                    }
+                if ( transformOutY != nullptr ) {
+                    transformOutY += widthOut;
                 }
             }
         }
@@ -1301,53 +1299,11 @@ namespace fheroes2
             const uint8_t * imageInY = in.image() + offsetInY;
             const uint8_t * transformInY = in.transform() + offsetInY;
 
-            const int32_t offsetOutY = outY * widthOut + outX;
-            uint8_t * imageOutY = out.image() + offsetOutY;
-            const uint8_t * imageInYEnd = imageInY + height * widthIn;
-
-            if ( out.singleLayer() ) {
-                assert( !in.singleLayer() );
-                for ( ; imageInY != imageInYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut ) {
-                    const uint8_t * imageInX = imageInY;
-                    const uint8_t * transformInX = transformInY;
-                    uint8_t * imageOutX = imageOutY;
-                    const uint8_t * imageInXEnd = imageInX + width;
+            for ( ; imageOutY != imageOutYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut ) {
+                blendRow( imageInY, transformInY, imageOutY, transformOutY, width, transformTable );
 
-                    for ( ; imageInX != imageInXEnd; ++imageInX, ++transformInX, ++imageOutX ) {
-                        if ( *transformInX > 0 ) { // apply a transformation
-                            if ( *transformInX != 1 ) { // skip pixel
-                                *imageOutX = *( transformTable + ( *transformInX ) * paletteSize + *imageOutX );
-                            }
-                        }
-                        else { // copy a pixel
-                            *imageOutX = *imageInX;
-                        }
-                    }
-                }
-            }
-            else {
-                uint8_t * transformOutY = out.transform() + offsetOutY;
-
-                for ( ; imageInY != imageInYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut, transformOutY += widthOut ) {
-                    const uint8_t * imageInX = imageInY;
-                    const uint8_t * transformInX = transformInY;
-                    uint8_t * imageOutX = imageOutY;
-                    uint8_t * transformOutX = transformOutY;
-                    const uint8_t * imageInXEnd = imageInX + width;
-
-                    for ( ; imageInX != imageInXEnd; ++imageInX, ++transformInX, ++imageOutX, ++transformOutX ) {
-                        if ( *transformInX == 1 ) { // skip pixel
-                            continue;
-                        }
-
-                        if ( *transformInX > 0 && *transformOutX == 0 ) { // apply a transformation
-                            *imageOutX = *( transformTable + ( *transformInX ) * paletteSize + *imageOutX );
-                        }
-                        else { // copy a pixel
-                            *transformOutX = *transformInX;
-                            *imageOutX = *imageInX;
-                        }
-                    }
+                if ( transformOutY != nullptr ) {
+                    transformOutY += widthOut;
                 }
             }
         }
@@ -2810,10 +2766,19 @@ namespace fheroes2
                 }
             }
 
-            for ( ; imageOutY != imageOutYEnd; imageOutY += widthOut, ++idY ) {
-                uint8_t * imageOutX = imageOutY;
+            int32_t prevOffset = -1;
 
+            for ( ; imageOutY != imageOutYEnd; imageOutY += widthOut, ++idY ) {
                 const int32_t offset = ( ( idY * heightRoiIn ) / heightRoiOut ) * widthIn;
+                if ( offset == prevOffset ) {
+                    // When upscaling the same input row is used for several output rows, so just copy the previous one.
+                    memcpy( imageOutY, imageOutY - widthOut, widthRoiOut );
+                    continue;
+                }
+
+                prevOffset = offset;
+
+                uint8_t * imageOutX = imageOutY;
                 const uint8_t * imageInX = imageInY + offset;
 
                 for ( const int32_t posX : positionX ) {
@@ -2825,27 +2790,27 @@ namespace fheroes2
         else if ( out.singleLayer() ) {
             const uint8_t * transformInY = in.transform() + offsetInY;
 
-            for ( ; imageOutY != imageOutYEnd; imageOutY += widthOut, ++idY ) {
-                uint8_t * imageOutX = imageOutY;
+            // Input pixels are gathered into temporary rows first so that the rows can be drawn by the row kernel.
+            std::vector<uint8_t> imageRow( widthRoiOut );
+            std::vector<uint8_t> transformRow( widthRoiOut );
 
+            int32_t prevOffset = -1;
+
+            for ( ; imageOutY != imageOutYEnd; imageOutY += widthOut, ++idY ) {
                 const int32_t offset = ( ( idY * heightRoiIn ) / heightRoiOut ) * widthIn;
-                const uint8_t * imageInX = imageInY + offset;
-                const uint8_t * transformInX = transformInY + offset;
+                if ( offset != prevOffset ) {
+                    prevOffset = offset;
 
-                for ( const int32_t posX : positionX ) {
-                    const uint8_t * transformIn = transformInX + posX;
-                    if ( *transformIn > 0 ) {
-                        if ( *transformIn != 1 ) {
-                            // Apply a transformation.
-                            *imageOutX = *( transformTable + static_cast<ptrdiff_t>( *transformIn ) * paletteSize + *imageOutX );
-                        }
-                    }
-                    else {
-                        *imageOutX = *( imageInX + posX );
-                    }
+                    const uint8_t * imageInX = imageInY + offset;
+                    const uint8_t * transformInX = transformInY + offset;
 
-                    ++imageOutX;
+                    for ( int32_t x = 0; x < widthRoiOut; ++x ) {
+                        imageRow[x] = imageInX[positionX[x]];
+                        transformRow[x] = transformInX[positionX[x]];
+                    }
                 }
+
+                blendRow( imageRow.data(), transformRow.data(), imageOutY, nullptr, widthRoiOut, transformTable );
             }
         }
         else {
@@ -2853,11 +2818,22 @@ namespace fheroes2
             const uint8_t * transformInY = in.transform() + offsetInY;
             uint8_t * transformOutY = out.transform() + offsetOutY;
 
+            int32_t prevOffset = -1;
+
             for ( ; imageOutY != imageOutYEnd; imageOutY += widthOut, transformOutY += widthOut, ++idY ) {
+                const int32_t offset = ( ( idY * heightRoiIn ) / heightRoiOut ) * widthIn;
+                if ( offset == prevOffset ) {
+                    // When upscaling the same input row is used for several output rows, so just copy the previous one.
+                    memcpy( imageOutY, imageOutY - widthOut, widthRoiOut );
+                    memcpy( transformOutY, transformOutY - widthOut, widthRoiOut );
+                    continue;
+                }
+
+                prevOffset = offset;
+
                 uint8_t * imageOutX = imageOutY;
                 uint8_t * transformOutX = transformOutY;
 
-                const int32_t offset = ( ( idY * heightRoiIn ) / heightRoiOut ) * widthIn;
                 const uint8_t * imageInX = imageInY + offset;
                 const uint8_t * transformInX = transformInY + offset;
 
@@ -0,0 +1,754 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "image_kernels.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#if defined( WITH_DEBUG )
+#include <cassert>
+#include <random>
+#include <vector>
+#endif
+
+#include "image_palette.h"
+#include "logging.h"
+
+#if defined( __x86_64__ ) || defined( __i386__ ) || defined( _M_X64 ) || defined( _M_IX86 )
+#define IMAGE_KERNELS_X86
+
+#include <immintrin.h>
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+
+// MSVC allows to use any instruction set intrinsics without special compilation flags.
+#define TARGET_SSE2
+#define TARGET_AVX2
+#else
+#define TARGET_SSE2 __attribute__( ( target( "sse2" ) ) )
+#define TARGET_AVX2 __attribute__( ( target( "avx2" ) ) )
+#endif
+#elif defined( __aarch64__ ) || defined( _M_ARM64 )
+// NEON is a mandatory part of AArch64 so no runtime check is needed.
+#define IMAGE_KERNELS_NEON
+
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+    using PaletteRowKernel = void ( * )( const uint8_t * in, uint8_t * out, const int32_t width, const uint8_t * palette );
+    using MaskedPaletteRowKernel = void ( * )( const uint8_t * in, const uint8_t * transform, uint8_t * out, const int32_t width, const uint8_t * palette );
+    using BlendRowKernel = void ( * )( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, uint8_t * transformOut, const int32_t width,
+                                       const uint8_t * transformTable );
+
+    struct ImageKernels
+    {
+        PaletteRowKernel applyPaletteToRow{ nullptr };
+        MaskedPaletteRowKernel applyPaletteToMaskedRow{ nullptr };
+        BlendRowKernel blendRow{ nullptr };
+
+        const char * instructionSet{ nullptr };
+    };
+
+    // Returns the number of consecutive bytes equal to the given value, starting from 'data' and going forward, but no more than 'maxLength'.
+    // Sprites have long runs of fully transparent or fully opaque pixels so 8 bytes are compared at once.
+    int32_t getForwardRunLength( const uint8_t * data, const int32_t maxLength, const uint8_t value )
+    {
+        const uint64_t pattern = value * 0x0101010101010101ULL;
+
+        int32_t length = 0;
+
+        for ( uint64_t block = 0; length + 8 <= maxLength; length += 8 ) {
+            memcpy( &block, data + length, sizeof( block ) );
+            if ( block != pattern ) {
+                break;
+            }
+        }
+
+        while ( length < maxLength && data[length] == value ) {
+            ++length;
+        }
+
+        return length;
+    }
+
+    void applyPaletteToRowScalar( const uint8_t * in, uint8_t * out, const int32_t width, const uint8_t * palette )
+    {
+        for ( int32_t x = 0; x < width; ++x ) {
+            out[x] = palette[in[x]];
+        }
+    }
+
+    void applyPaletteToMaskedRowScalar( const uint8_t * in, const uint8_t * transform, uint8_t * out, const int32_t width, const uint8_t * palette )
+    {
+        int32_t x = 0;
+
+        while ( x < width ) {
+            // Only modify pixels with data. Runs of such pixels are processed without checking every pixel.
+            const int32_t runEnd = x + getForwardRunLength( transform + x, width - x, 0 );
+
+            for ( ; x < runEnd; ++x ) {
+                out[x] = palette[in[x]];
+            }
+
+            if ( x < width ) {
+                x += std::max( getForwardRunLength( transform + x, width - x, 1 ), 1 );
+            }
+        }
+    }
+
+    // Applies a transformation to a pixel or copies it if the output pixel has a transform value itself.
+    void blendTransformPixel( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, uint8_t * transformOut, const int32_t x,
+                              const uint8_t * transformTable )
+    {
+        if ( transformOut == nullptr || transformOut[x] == 0 ) {
+            imageOut[x] = transformTable[static_cast<ptrdiff_t>( transformIn[x] ) * fheroes2::paletteSize + imageOut[x]];
+        }
+        else {
+            transformOut[x] = transformIn[x];
+            imageOut[x] = imageIn[x];
+        }
+    }
+
+    // Runs of opaque pixels are copied at once and runs of transparent pixels are skipped at once.
+    void blendRowScalar( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, uint8_t * transformOut, const int32_t width,
+                         const uint8_t * transformTable )
+    {
+        int32_t x = 0;
+
+        while ( x < width ) {
+            const uint8_t transformValue = transformIn[x];
+
+            if ( transformValue == 0 ) { // copy pixels
+                const int32_t length = getForwardRunLength( transformIn + x, width - x, 0 );
+
+                memcpy( imageOut + x, imageIn + x, static_cast<size_t>( length ) );
+                if ( transformOut != nullptr ) {
+                    memset( transformOut + x, 0, static_cast<size_t>( length ) );
+                }
+
+                x += length;
+            }
+            else if ( transformValue == 1 ) { // skip pixels
+                x += getForwardRunLength( transformIn + x, width - x, 1 );
+            }
+            else {
+                blendTransformPixel( imageIn, transformIn, imageOut, transformOut, x, transformTable );
+                ++x;
+            }
+        }
+    }
+
+#if defined( IMAGE_KERNELS_X86 )
+    bool isSse2Supported()
+    {
+#if defined( __x86_64__ ) || defined( _M_X64 )
+        // SSE2 is a mandatory part of x86-64.
+        return true;
+#elif defined( _MSC_VER )
+        int info[4];
+        __cpuid( info, 1 );
+
+        return ( info[3] & ( 1 << 26 ) ) != 0;
+#else
+        __builtin_cpu_init();
+
+        return __builtin_cpu_supports( "sse2" );
+#endif
+    }
+
+    bool isAvx2Supported()
+    {
+#if defined( _MSC_VER )
+        int info[4];
+        __cpuid( info, 0 );
+        if ( info[0] < 7 ) {
+            return false;
+        }
+
+        // The OS must save AVX registers on context switches: check OSXSAVE and AVX flags and then the enabled register state.
+        __cpuid( info, 1 );
+        if ( ( info[2] & ( 1 << 27 ) ) == 0 || ( info[2] & ( 1 << 28 ) ) == 0 || ( _xgetbv( 0 ) & 6 ) != 6 ) {
+            return false;
+        }
+
+        __cpuidex( info, 7, 0 );
+
+        return ( info[1] & ( 1 << 5 ) ) != 0;
+#else
+        __builtin_cpu_init();
+
+        return __builtin_cpu_supports( "avx2" );
+#endif
+    }
+
+    TARGET_SSE2 void blendRowSse2( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, uint8_t * transformOut, const int32_t width,
+                                   const uint8_t * transformTable )
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i one = _mm_set1_epi8( 1 );
+
+        int32_t x = 0;
+
+        for ( ; x + 16 <= width; x += 16 ) {
+            const __m128i transform = _mm_loadu_si128( reinterpret_cast<const __m128i *>( transformIn + x ) );
+
+            const __m128i isSkip = _mm_cmpeq_epi8( transform, one );
+            const uint32_t skipBits = static_cast<uint32_t>( _mm_movemask_epi8( isSkip ) );
+            if ( skipBits == 0xFFFFU ) {
+                continue;
+            }
+
+            const __m128i isCopy = _mm_cmpeq_epi8( transform, zero );
+            const uint32_t copyBits = static_cast<uint32_t>( _mm_movemask_epi8( isCopy ) );
+            if ( copyBits == 0xFFFFU ) {
+                _mm_storeu_si128( reinterpret_cast<__m128i *>( imageOut + x ), _mm_loadu_si128( reinterpret_cast<const __m128i *>( imageIn + x ) ) );
+                if ( transformOut != nullptr ) {
+                    _mm_storeu_si128( reinterpret_cast<__m128i *>( transformOut + x ), zero );
+                }
+                continue;
+            }
+
+            if ( ( copyBits | skipBits ) == 0xFFFFU ) {
+                // Only copied and skipped pixels.
+                const __m128i imageOld = _mm_loadu_si128( reinterpret_cast<const __m128i *>( imageOut + x ) );
+                const __m128i image = _mm_loadu_si128( reinterpret_cast<const __m128i *>( imageIn + x ) );
+                _mm_storeu_si128( reinterpret_cast<__m128i *>( imageOut + x ), _mm_or_si128( _mm_and_si128( isCopy, image ), _mm_andnot_si128( isCopy, imageOld ) ) );
+
+                if ( transformOut != nullptr ) {
+                    const __m128i transformOld = _mm_loadu_si128( reinterpret_cast<const __m128i *>( transformOut + x ) );
+                    _mm_storeu_si128( reinterpret_cast<__m128i *>( transformOut + x ), _mm_andnot_si128( isCopy, transformOld ) );
+                }
+                continue;
+            }
+
+            // There is no byte table lookup in SSE2 so transformations are applied pixel by pixel.
+            for ( int32_t i = 0; i < 16; ++i ) {
+                if ( ( copyBits >> i ) & 1 ) {
+                    imageOut[x + i] = imageIn[x + i];
+                    if ( transformOut != nullptr ) {
+                        transformOut[x + i] = 0;
+                    }
+                }
+                else if ( ( ( skipBits >> i ) & 1 ) == 0 ) {
+                    blendTransformPixel( imageIn, transformIn, imageOut, transformOut, x + i, transformTable );
+                }
+            }
+        }
+
+        blendRowScalar( imageIn + x, transformIn + x, imageOut + x, transformOut == nullptr ? nullptr : transformOut + x, width - x, transformTable );
+    }
+
+    // Returns the values from the given 256-entry table for every byte. The table is split into 16 parts of 16 entries. The lower 4 bits of a value
+    // select an entry within each part by a byte shuffle and the upper 4 bits select the part.
+    TARGET_AVX2 __m256i lookupAvx2( const __m256i value, const uint8_t * table )
+    {
+        const __m256i lowBitsMask = _mm256_set1_epi8( 0x0F );
+        const __m256i one = _mm256_set1_epi8( 1 );
+        const __m256i zero = _mm256_setzero_si256();
+
+        const __m256i entryId = _mm256_and_si256( value, lowBitsMask );
+        __m256i partId = _mm256_and_si256( _mm256_srli_epi16( value, 4 ), lowBitsMask );
+
+        __m256i result = zero;
+
+        for ( int32_t part = 0; part < 16; ++part, table += 16 ) {
+            const __m256i entries = _mm256_shuffle_epi8( _mm256_broadcastsi128_si256( _mm_loadu_si128( reinterpret_cast<const __m128i *>( table ) ) ), entryId );
+
+            result = _mm256_or_si256( result, _mm256_and_si256( entries, _mm256_cmpeq_epi8( partId, zero ) ) );
+            partId = _mm256_sub_epi8( partId, one );
+        }
+
+        return result;
+    }
+
+    // Prepares a 256-entry table for lookupPreparedAvx2(). Each half of the table is split into 8 parts of 16 entries and every part is XORed
+    // with the previous one within the same half.
+    TARGET_AVX2 void prepareLookupTableAvx2( const uint8_t * table, __m256i * parts )
+    {
+        __m256i previous = _mm256_setzero_si256();
+
+        for ( int32_t part = 0; part < 16; ++part, table += 16 ) {
+            if ( part == 8 ) {
+                previous = _mm256_setzero_si256();
+            }
+
+            const __m256i current = _mm256_broadcastsi128_si256( _mm_loadu_si128( reinterpret_cast<const __m128i *>( table ) ) );
+            parts[part] = _mm256_xor_si256( current, previous );
+            previous = current;
+        }
+    }
+
+    // Returns the values from the prepared table for every byte. A byte shuffle returns 0 when the highest bit of an index is set. The index
+    // is reduced by 16 for every next part with signed saturation so for a value from the part N the first N + 1 parts of its half return
+    // non-zero results and their XOR gives the table entry. The other half of the table gets indices with the highest bit set and returns 0.
+    TARGET_AVX2 __m256i lookupPreparedAvx2( const __m256i value, const __m256i * parts )
+    {
+        const __m256i partSize = _mm256_set1_epi8( 16 );
+
+        __m256i lowerId = value;
+        __m256i upperId = _mm256_xor_si256( value, _mm256_set1_epi8( static_cast<char>( 0x80 ) ) );
+
+        __m256i lowerResult = _mm256_setzero_si256();
+        __m256i upperResult = _mm256_setzero_si256();
+
+        for ( int32_t part = 0; part < 8; ++part ) {
+            lowerResult = _mm256_xor_si256( lowerResult, _mm256_shuffle_epi8( parts[part], lowerId ) );
+            upperResult = _mm256_xor_si256( upperResult, _mm256_shuffle_epi8( parts[part + 8], upperId ) );
+
+            lowerId = _mm256_subs_epi8( lowerId, partSize );
+            upperId = _mm256_subs_epi8( upperId, partSize );
+        }
+
+        return _mm256_or_si256( lowerResult, upperResult );
+    }
+
+    TARGET_AVX2 void applyPaletteToRowAvx2( const uint8_t * in, uint8_t * out, const int32_t width, const uint8_t * palette )
+    {
+        int32_t x = 0;
+
+        if ( width >= 32 ) {
+            __m256i parts[16];
+            prepareLookupTableAvx2( palette, parts );
+
+            for ( ; x + 32 <= width; x += 32 ) {
+                const __m256i value = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( in + x ) );
+                _mm256_storeu_si256( reinterpret_cast<__m256i *>( out + x ), lookupPreparedAvx2( value, parts ) );
+            }
+        }
+
+        applyPaletteToRowScalar( in + x, out + x, width - x, palette );
+    }
+
+    TARGET_AVX2 void applyPaletteToMaskedRowAvx2( const uint8_t * in, const uint8_t * transform, uint8_t * out, const int32_t width, const uint8_t * palette )
+    {
+        const __m256i zero = _mm256_setzero_si256();
+
+        int32_t x = 0;
+
+        if ( width >= 32 ) {
+            __m256i parts[16];
+            prepareLookupTableAvx2( palette, parts );
+
+            for ( ; x + 32 <= width; x += 32 ) {
+                const __m256i isData = _mm256_cmpeq_epi8( _mm256_loadu_si256( reinterpret_cast<const __m256i *>( transform + x ) ), zero );
+                const uint32_t dataBits = static_cast<uint32_t>( _mm256_movemask_epi8( isData ) );
+                if ( dataBits == 0 ) {
+                    continue;
+                }
+
+                const __m256i value = lookupPreparedAvx2( _mm256_loadu_si256( reinterpret_cast<const __m256i *>( in + x ) ), parts );
+
+                if ( dataBits == 0xFFFFFFFFU ) {
+                    _mm256_storeu_si256( reinterpret_cast<__m256i *>( out + x ), value );
+                }
+                else {
+                    const __m256i valueOld = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( out + x ) );
+                    _mm256_storeu_si256( reinterpret_cast<__m256i *>( out + x ), _mm256_blendv_epi8( valueOld, value, isData ) );
+                }
+            }
+        }
+
+        applyPaletteToMaskedRowScalar( in + x, transform + x, out + x, width - x, palette );
+    }
+
+    TARGET_AVX2 void blendRowAvx2( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, uint8_t * transformOut, const int32_t width,
+                                   const uint8_t * transformTable )
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i one = _mm256_set1_epi8( 1 );
+        const __m256i allBits = _mm256_set1_epi8( -1 );
+
+        int32_t x = 0;
+
+        for ( ; x + 32 <= width; x += 32 ) {
+            const __m256i transform = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( transformIn + x ) );
+
+            const __m256i isSkip = _mm256_cmpeq_epi8( transform, one );
+            if ( static_cast<uint32_t>( _mm256_movemask_epi8( isSkip ) ) == 0xFFFFFFFFU ) {
+                continue;
+            }
+
+            const __m256i isCopy = _mm256_cmpeq_epi8( transform, zero );
+            const __m256i image = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( imageIn + x ) );
+            if ( static_cast<uint32_t>( _mm256_movemask_epi8( isCopy ) ) == 0xFFFFFFFFU ) {
+                _mm256_storeu_si256( reinterpret_cast<__m256i *>( imageOut + x ), image );
+                if ( transformOut != nullptr ) {
+                    _mm256_storeu_si256( reinterpret_cast<__m256i *>( transformOut + x ), zero );
+                }
+                continue;
+            }
+
+            const __m256i isTransform = _mm256_xor_si256( _mm256_or_si256( isCopy, isSkip ), allBits );
+
+            // Pixels with a transform value are copied if the output pixel has a transform value as well.
+            __m256i isApply = isTransform;
+            __m256i isPixelCopy = isCopy;
+            __m256i transformOld = zero;
+
+            if ( transformOut != nullptr ) {
+                transformOld = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( transformOut + x ) );
+
+                const __m256i isOutputData = _mm256_cmpeq_epi8( transformOld, zero );
+                isApply = _mm256_and_si256( isTransform, isOutputData );
+                isPixelCopy = _mm256_or_si256( isCopy, _mm256_andnot_si256( isOutputData, isTransform ) );
+            }
+
+            __m256i imageNew = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( imageOut + x ) );
+            uint32_t applyBits = static_cast<uint32_t>( _mm256_movemask_epi8( isApply ) );
+
+            if ( applyBits != 0 ) {
+                // Shadows and other effects usually have the same transform value for the whole area so all such pixels are processed at once.
+                int32_t firstApplyId = 0;
+                while ( ( ( applyBits >> firstApplyId ) & 1 ) == 0 ) {
+                    ++firstApplyId;
+                }
+
+                const uint8_t transformValue = transformIn[x + firstApplyId];
+                const __m256i isSameApply = _mm256_and_si256( isApply, _mm256_cmpeq_epi8( transform, _mm256_set1_epi8( static_cast<char>( transformValue ) ) ) );
+                const uint8_t * table = transformTable + static_cast<ptrdiff_t>( transformValue ) * fheroes2::paletteSize;
+
+                imageNew = _mm256_blendv_epi8( imageNew, lookupAvx2( imageNew, table ), isSameApply );
+                applyBits &= ~static_cast<uint32_t>( _mm256_movemask_epi8( isSameApply ) );
+            }
+
+            _mm256_storeu_si256( reinterpret_cast<__m256i *>( imageOut + x ), _mm256_blendv_epi8( imageNew, image, isPixelCopy ) );
+            if ( transformOut != nullptr ) {
+                // Copied pixels with the transform value 0 make the output transform value 0 as well.
+                _mm256_storeu_si256( reinterpret_cast<__m256i *>( transformOut + x ), _mm256_blendv_epi8( transformOld, transform, isPixelCopy ) );
+            }
+
+            // The rest of pixels have different transform values and they are not modified yet.
+            for ( int32_t i = 0; applyBits != 0; ++i, applyBits >>= 1 ) {
+                if ( applyBits & 1 ) {
+                    imageOut[x + i] = transformTable[static_cast<ptrdiff_t>( transformIn[x + i] ) * fheroes2::paletteSize + imageOut[x + i]];
+                }
+            }
+        }
+
+        blendRowScalar( imageIn + x, transformIn + x, imageOut + x, transformOut == nullptr ? nullptr : transformOut + x, width - x, transformTable );
+    }
+#endif
+
+#if defined( IMAGE_KERNELS_NEON )
+    // Returns the values from the given 256-entry table for every byte. Each table lookup instruction covers 64 entries. Indices out of the range
+    // return 0 for the first lookup and keep the previous result for the next ones.
+    uint8x16_t lookupNeon( const uint8x16_t value, const uint8_t * table )
+    {
+        const uint8x16_t partSize = vdupq_n_u8( 64 );
+
+        uint8x16_t entryId = value;
+        uint8x16_t result = vdupq_n_u8( 0 );
+
+        for ( int32_t part = 0; part < 4; ++part, table += 64 ) {
+            uint8x16x4_t entries;
+            entries.val[0] = vld1q_u8( table );
+            entries.val[1] = vld1q_u8( table + 16 );
+            entries.val[2] = vld1q_u8( table + 32 );
+            entries.val[3] = vld1q_u8( table + 48 );
+
+            result = ( part == 0 ) ? vqtbl4q_u8( entries, entryId ) : vqtbx4q_u8( result, entries, entryId );
+            entryId = vsubq_u8( entryId, partSize );
+        }
+
+        return result;
+    }
+
+    void applyPaletteToRowNeon( const uint8_t * in, uint8_t * out, const int32_t width, const uint8_t * palette )
+    {
+        int32_t x = 0;
+
+        for ( ; x + 16 <= width; x += 16 ) {
+            vst1q_u8( out + x, lookupNeon( vld1q_u8( in + x ), palette ) );
+        }
+
+        applyPaletteToRowScalar( in + x, out + x, width - x, palette );
+    }
+
+    void applyPaletteToMaskedRowNeon( const uint8_t * in, const uint8_t * transform, uint8_t * out, const int32_t width, const uint8_t * palette )
+    {
+        int32_t x = 0;
+
+        for ( ; x + 16 <= width; x += 16 ) {
+            const uint8x16_t isData = vceqzq_u8( vld1q_u8( transform + x ) );
+            if ( vmaxvq_u8( isData ) == 0 ) {
+                continue;
+            }
+
+            vst1q_u8( out + x, vbslq_u8( isData, lookupNeon( vld1q_u8( in + x ), palette ), vld1q_u8( out + x ) ) );
+        }
+
+        applyPaletteToMaskedRowScalar( in + x, transform + x, out + x, width - x, palette );
+    }
+
+    void blendRowNeon( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, uint8_t * transformOut, const int32_t width,
+                       const uint8_t * transformTable )
+    {
+        const uint8x16_t one = vdupq_n_u8( 1 );
+
+        int32_t x = 0;
+
+        for ( ; x + 16 <= width; x += 16 ) {
+            const uint8x16_t transform = vld1q_u8( transformIn + x );
+
+            const uint8x16_t isSkip = vceqq_u8( transform, one );
+            if ( vminvq_u8( isSkip ) != 0 ) {
+                continue;
+            }
+
+            const uint8x16_t isCopy = vceqzq_u8( transform );
+            const uint8x16_t image = vld1q_u8( imageIn + x );
+            if ( vminvq_u8( isCopy ) != 0 ) {
+                vst1q_u8( imageOut + x, image );
+                if ( transformOut != nullptr ) {
+                    vst1q_u8( transformOut + x, vdupq_n_u8( 0 ) );
+                }
+                continue;
+            }
+
+            const uint8x16_t isTransform = vmvnq_u8( vorrq_u8( isCopy, isSkip ) );
+
+            // Pixels with a transform value are copied if the output pixel has a transform value as well.
+            uint8x16_t isApply = isTransform;
+            uint8x16_t isPixelCopy = isCopy;
+            uint8x16_t transformOld = vdupq_n_u8( 0 );
+
+            if ( transformOut != nullptr ) {
+                transformOld = vld1q_u8( transformOut + x );
+
+                const uint8x16_t isOutputData = vceqzq_u8( transformOld );
+                isApply = vandq_u8( isTransform, isOutputData );
+                isPixelCopy = vorrq_u8( isCopy, vbicq_u8( isTransform, isOutputData ) );
+            }
+
+            uint8x16_t imageNew = vld1q_u8( imageOut + x );
+
+            if ( vmaxvq_u8( isApply ) != 0 ) {
+                // Shadows and other effects usually have the same transform value for the whole area so all such pixels are processed at once.
+                uint8_t applyFlags[16];
+                vst1q_u8( applyFlags, isApply );
+
+                int32_t firstApplyId = 0;
+                while ( applyFlags[firstApplyId] == 0 ) {
+                    ++firstApplyId;
+                }
+
+                const uint8_t transformValue = transformIn[x + firstApplyId];
+                const uint8x16_t isSameApply = vandq_u8( isApply, vceqq_u8( transform, vdupq_n_u8( transformValue ) ) );
+                const uint8_t * table = transformTable + static_cast<ptrdiff_t>( transformValue ) * fheroes2::paletteSize;
+
+                imageNew = vbslq_u8( isSameApply, lookupNeon( imageNew, table ), imageNew );
+                isApply = vbicq_u8( isApply, isSameApply );
+            }
+
+            vst1q_u8( imageOut + x, vbslq_u8( isPixelCopy, image, imageNew ) );
+            if ( transformOut != nullptr ) {
+                // Copied pixels with the transform value 0 make the output transform value 0 as well.
+                vst1q_u8( transformOut + x, vbslq_u8( isPixelCopy, transform, transformOld ) );
+            }
+
+            if ( vmaxvq_u8( isApply ) != 0 ) {
+                // The rest of pixels have different transform values and they are not modified yet.
+                uint8_t applyFlags[16];
+                vst1q_u8( applyFlags, isApply );
+
+                for ( int32_t i = 0; i < 16; ++i ) {
+                    if ( applyFlags[i] != 0 ) {
+                        imageOut[x + i] = transformTable[static_cast<ptrdiff_t>( transformIn[x + i] ) * fheroes2::paletteSize + imageOut[x + i]];
+                    }
+                }
+            }
+        }
+
+        blendRowScalar( imageIn + x, transformIn + x, imageOut + x, transformOut == nullptr ? nullptr : transformOut + x, width - x, transformTable );
+    }
+#endif
+
+#if defined( WITH_DEBUG )
+    // Compares the results of the given kernels with the results of the scalar ones on random data. Rows of various widths
+    // are filled by runs of different transform values to cover all code paths of vectorized kernels.
+    bool areKernelsEquivalentToScalar( const ImageKernels & kernels )
+    {
+        std::mt19937 generator( 0 );
+
+        const auto getRandomValue = [&generator]( const uint32_t minValue, const uint32_t maxValue ) {
+            return std::uniform_int_distribution<uint32_t>( minValue, maxValue )( generator );
+        };
+
+        const auto getRandomRow = [&getRandomValue]( const size_t size ) {
+            std::vector<uint8_t> row( size );
+            for ( uint8_t & value : row ) {
+                value = static_cast<uint8_t>( getRandomValue( 0, 255 ) );
+            }
+            return row;
+        };
+
+        // Transform values above 15 do not exist as the transform table has only 16 parts.
+        const auto getRandomTransformRow = [&getRandomValue]( const size_t size, const bool hasTransparency ) {
+            std::vector<uint8_t> row( size );
+
+            for ( size_t x = 0; x < size; ) {
+                const size_t runEnd = std::min( size, x + getRandomValue( 1, 48 ) );
+                const uint32_t runType = getRandomValue( 0, 3 );
+                const uint8_t runValue = static_cast<uint8_t>( hasTransparency ? getRandomValue( 0, 15 ) : getRandomValue( 2, 15 ) );
+
+                for ( ; x < runEnd; ++x ) {
+                    if ( runType == 3 ) {
+                        row[x] = static_cast<uint8_t>( hasTransparency ? getRandomValue( 0, 15 ) : getRandomValue( 0, 1 ) * getRandomValue( 2, 15 ) );
+                    }
+                    else if ( hasTransparency ) {
+                        row[x] = ( runType == 2 ) ? runValue : static_cast<uint8_t>( runType );
+                    }
+                    else {
+                        row[x] = ( runType == 2 ) ? runValue : 0;
+                    }
+                }
+            }
+
+            return row;
+        };
+
+        const std::vector<uint8_t> transformTable = getRandomRow( 16 * fheroes2::paletteSize );
+
+        for ( int32_t test = 0; test < 2000; ++test ) {
+            const int32_t width = static_cast<int32_t>( getRandomValue( 1, 160 ) );
+            const size_t size = static_cast<size_t>( width );
+
+            const std::vector<uint8_t> palette = getRandomRow( fheroes2::paletteSize );
+            const std::vector<uint8_t> imageIn = getRandomRow( size );
+            const std::vector<uint8_t> imageOut = getRandomRow( size );
+            const std::vector<uint8_t> transformIn = getRandomTransformRow( size, true );
+            const std::vector<uint8_t> transformOut = getRandomTransformRow( size, false );
+
+            std::vector<uint8_t> expected = imageOut;
+            std::vector<uint8_t> actual = imageOut;
+
+            applyPaletteToRowScalar( imageIn.data(), expected.data(), width, palette.data() );
+            kernels.applyPaletteToRow( imageIn.data(), actual.data(), width, palette.data() );
+            if ( expected != actual ) {
+                ERROR_LOG( "Palette row kernel mismatch for the width " << width )
+                return false;
+            }
+
+            // The input and output rows can be the same.
+            expected = imageIn;
+            actual = imageIn;
+
+            applyPaletteToMaskedRowScalar( expected.data(), transformIn.data(), expected.data(), width, palette.data() );
+            kernels.applyPaletteToMaskedRow( actual.data(), transformIn.data(), actual.data(), width, palette.data() );
+            if ( expected != actual ) {
+                ERROR_LOG( "Masked palette row kernel mismatch for the width " << width )
+                return false;
+            }
+
+            expected = imageOut;
+            actual = imageOut;
+
+            blendRowScalar( imageIn.data(), transformIn.data(), expected.data(), nullptr, width, transformTable.data() );
+            kernels.blendRow( imageIn.data(), transformIn.data(), actual.data(), nullptr, width, transformTable.data() );
+            if ( expected != actual ) {
+                ERROR_LOG( "Blend row kernel mismatch for the width " << width )
+                return false;
+            }
+
+            expected = imageOut;
+            actual = imageOut;
+
+            std::vector<uint8_t> expectedTransform = transformOut;
+            std::vector<uint8_t> actualTransform = transformOut;
+
+            blendRowScalar( imageIn.data(), transformIn.data(), expected.data(), expectedTransform.data(), width, transformTable.data() );
+            kernels.blendRow( imageIn.data(), transformIn.data(), actual.data(), actualTransform.data(), width, transformTable.data() );
+            if ( expected != actual || expectedTransform != actualTransform ) {
+                ERROR_LOG( "Double-layer blend row kernel mismatch for the width " << width )
+                return false;
+            }
+        }
+
+        return true;
+    }
+#endif
+
+    ImageKernels getScalarKernels()
+    {
+        return { applyPaletteToRowScalar, applyPaletteToMaskedRowScalar, blendRowScalar, "scalar" };
+    }
+
+    ImageKernels selectKernels()
+    {
+        ImageKernels kernels = getScalarKernels();
+
+#if defined( IMAGE_KERNELS_X86 )
+        if ( isAvx2Supported() ) {
+            kernels = { applyPaletteToRowAvx2, applyPaletteToMaskedRowAvx2, blendRowAvx2, "AVX2" };
+        }
+        else if ( isSse2Supported() ) {
+            // SSE2 has no byte table lookup so only the blending is vectorized.
+            kernels.blendRow = blendRowSse2;
+            kernels.instructionSet = "SSE2";
+        }
+#elif defined( IMAGE_KERNELS_NEON )
+        kernels = { applyPaletteToRowNeon, applyPaletteToMaskedRowNeon, blendRowNeon, "NEON" };
+#endif
+
+#if defined( WITH_DEBUG )
+        if ( !areKernelsEquivalentToScalar( kernels ) ) {
+            // If this assertion blows up then the vectorized kernels produce different results. Fix them!
+            assert( 0 );
+
+            ERROR_LOG( "Image kernels for " << kernels.instructionSet << " produce wrong results, falling back to scalar ones." )
+            return getScalarKernels();
+        }
+#endif
+
+        DEBUG_LOG( DBG_ENGINE, DBG_INFO, "Using " << kernels.instructionSet << " image kernels." )
+
+        return kernels;
+    }
+
+    const ImageKernels & getKernels()
+    {
+        static const ImageKernels kernels = selectKernels();
+        return kernels;
+    }
+}
+
+namespace fheroes2
+{
+    void applyPaletteToRow( const uint8_t * in, uint8_t * out, const int32_t width, const uint8_t * palette )
+    {
+        getKernels().applyPaletteToRow( in, out, width, palette );
+    }
+
+    void applyPaletteToMaskedRow( const uint8_t * in, const uint8_t * transform, uint8_t * out, const int32_t width, const uint8_t * palette )
+    {
+        getKernels().applyPaletteToMaskedRow( in, transform, out, width, palette );
+    }
+
+    void blendRow( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, uint8_t * transformOut, const int32_t width,
+                   const uint8_t * transformTable )
+    {
+        getKernels().blendRow( imageIn, transformIn, imageOut, transformOut, width, transformTable );
+    }
+}
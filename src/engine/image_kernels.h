@@ -0,0 +1,39 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+// Row kernels used by image functions. Besides the scalar versions there are vectorized ones (SSE2 and AVX2 on x86, NEON on AArch64)
+// which are selected at runtime based on the CPU capabilities. All versions produce exactly the same results.
+namespace fheroes2
+{
+    // Sets every output pixel to the palette value of the corresponding input pixel. The input and output rows can be the same.
+    void applyPaletteToRow( const uint8_t * in, uint8_t * out, const int32_t width, const uint8_t * palette );
+
+    // The same as applyPaletteToRow() but only pixels with the transform value 0 are modified.
+    void applyPaletteToMaskedRow( const uint8_t * in, const uint8_t * transform, uint8_t * out, const int32_t width, const uint8_t * palette );
+
+    // Draws a row of a double-layer image. Pixels with the transform value 0 are copied, pixels with the transform value 1 are skipped
+    // and other transform values are applied to the output pixels through the transform table. The transform layer of the output row is optional.
+    void blendRow( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, uint8_t * transformOut, const int32_t width,
+                   const uint8_t * transformTable );
+}
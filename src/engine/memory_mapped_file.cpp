@@ -0,0 +1,161 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "memory_mapped_file.h"
+
+#if defined( _WIN32 )
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif !defined( TARGET_PS_VITA ) && !defined( TARGET_NINTENDO_SWITCH )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "logging.h"
+
+namespace fheroes2
+{
+    bool MemoryMappedFile::open( const std::string & fileName )
+    {
+        close();
+
+#if defined( _WIN32 )
+        const HANDLE file = CreateFileA( fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+        if ( file == INVALID_HANDLE_VALUE ) {
+            ERROR_LOG( "Error opening file " << fileName )
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if ( !GetFileSizeEx( file, &fileSize ) || fileSize.QuadPart <= 0 ) {
+            CloseHandle( file );
+            return false;
+        }
+
+        // The mapping keeps the file open so the file handle is not needed anymore.
+        const HANDLE mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+        CloseHandle( file );
+
+        if ( mapping == nullptr ) {
+            ERROR_LOG( "Error mapping file " << fileName )
+            return false;
+        }
+
+        const void * data = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+        if ( data == nullptr ) {
+            ERROR_LOG( "Error mapping file " << fileName )
+            CloseHandle( mapping );
+            return false;
+        }
+
+        _mappingHandle = mapping;
+        _data = static_cast<const uint8_t *>( data );
+        _size = static_cast<size_t>( fileSize.QuadPart );
+#elif defined( TARGET_PS_VITA ) || defined( TARGET_NINTENDO_SWITCH )
+        if ( !_fileStream.open( fileName, "rb" ) ) {
+            return false;
+        }
+
+        const size_t fileSize = _fileStream.size();
+        if ( fileSize == 0 || _fileStream.fail() ) {
+            _fileStream.close();
+            return false;
+        }
+
+        _size = fileSize;
+#else
+        const int file = ::open( fileName.c_str(), O_RDONLY );
+        if ( file < 0 ) {
+            ERROR_LOG( "Error opening file " << fileName )
+            return false;
+        }
+
+        struct stat fileInfo;
+        if ( fstat( file, &fileInfo ) != 0 || fileInfo.st_size <= 0 ) {
+            ::close( file );
+            return false;
+        }
+
+        const size_t fileSize = static_cast<size_t>( fileInfo.st_size );
+
+        // The mapping keeps the file open so the file descriptor is not needed anymore.
+        void * data = mmap( nullptr, fileSize, PROT_READ, MAP_PRIVATE, file, 0 );
+        ::close( file );
+
+        if ( data == MAP_FAILED ) {
+            ERROR_LOG( "Error mapping file " << fileName )
+            return false;
+        }
+
+        _data = static_cast<const uint8_t *>( data );
+        _size = fileSize;
+#endif
+
+        return true;
+    }
+
+    void MemoryMappedFile::close()
+    {
+        if ( _size == 0 ) {
+            return;
+        }
+
+#if defined( _WIN32 )
+        UnmapViewOfFile( _data );
+        CloseHandle( _mappingHandle );
+
+        _data = nullptr;
+        _mappingHandle = nullptr;
+#elif defined( TARGET_PS_VITA ) || defined( TARGET_NINTENDO_SWITCH )
+        _fileStream.close();
+#else
+        munmap( const_cast<uint8_t *>( _data ), _size );
+
+        _data = nullptr;
+#endif
+
+        _size = 0;
+    }
+
+    FileData MemoryMappedFile::read( const size_t offset, const size_t size ) const
+    {
+        if ( size == 0 || offset > _size || size > _size - offset ) {
+            return {};
+        }
+
+#if defined( TARGET_PS_VITA ) || defined( TARGET_NINTENDO_SWITCH )
+        const std::scoped_lock<std::mutex> lock( _fileMutex );
+
+        _fileStream.seek( offset );
+
+        std::vector<uint8_t> content = _fileStream.getRaw( size );
+        if ( content.size() != size ) {
+            ERROR_LOG( "Error reading " << size << " bytes of a file at offset " << offset )
+            return {};
+        }
+
+        return FileData( std::move( content ) );
+#else
+        return { _data + offset, size };
+#endif
+    }
+}
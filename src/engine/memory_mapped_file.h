@@ -0,0 +1,133 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined( TARGET_PS_VITA ) || defined( TARGET_NINTENDO_SWITCH )
+#include <mutex>
+
+#include "serialize.h"
+#endif
+
+namespace fheroes2
+{
+    // A part of file content. It either points to the memory mapped content of the file or owns the data read from the file.
+    class FileData final
+    {
+    public:
+        FileData() = default;
+
+        FileData( const uint8_t * data, const size_t size )
+            : _data( data )
+            , _size( size )
+        {
+            // Do nothing.
+        }
+
+        explicit FileData( std::vector<uint8_t> content )
+            : _content( std::move( content ) )
+            , _data( _content.data() )
+            , _size( _content.size() )
+        {
+            // Do nothing.
+        }
+
+        FileData( const FileData & ) = delete;
+        FileData( FileData && ) = default;
+
+        ~FileData() = default;
+
+        FileData & operator=( const FileData & ) = delete;
+        FileData & operator=( FileData && ) = default;
+
+        const uint8_t * data() const
+        {
+            return _data;
+        }
+
+        size_t size() const
+        {
+            return _size;
+        }
+
+    private:
+        // Moving of a vector keeps its data at the same address, so the pointer below stays valid after moving of this object.
+        std::vector<uint8_t> _content;
+
+        const uint8_t * _data{ nullptr };
+        size_t _size{ 0 };
+    };
+
+    // Read-only content of a file. The file is mapped into memory on platforms supporting it, otherwise the requested parts of the file
+    // are read on demand. The content is never modified after opening so it can be accessed from multiple threads at the same time.
+    class MemoryMappedFile final
+    {
+    public:
+        MemoryMappedFile() = default;
+
+        MemoryMappedFile( const MemoryMappedFile & ) = delete;
+
+        ~MemoryMappedFile()
+        {
+            close();
+        }
+
+        MemoryMappedFile & operator=( const MemoryMappedFile & ) = delete;
+
+        // Returns false if the file does not exist, is empty or cannot be mapped.
+        bool open( const std::string & fileName );
+
+        void close();
+
+        bool isOpen() const
+        {
+            return _size > 0;
+        }
+
+        size_t size() const
+        {
+            return _size;
+        }
+
+        // Returns the given part of the file or empty data if the part is out of the file. On platforms without memory mapping support
+        // the data is read from the file, so it is better not to keep the result for long.
+        FileData read( const size_t offset, const size_t size ) const;
+
+    private:
+        size_t _size{ 0 };
+
+#if defined( TARGET_PS_VITA ) || defined( TARGET_NINTENDO_SWITCH )
+        // The file is read on demand. The mutex protects the position in the file which is shared by all reading threads.
+        mutable StreamFile _fileStream;
+        mutable std::mutex _fileMutex;
+#else
+        const uint8_t * _data{ nullptr };
+
+        // Platform specific handle of the mapping. It is used only on Windows.
+        void * _mappingHandle{ nullptr };
+#endif
+    };
+}
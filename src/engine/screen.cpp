@@ -25,10 +25,13 @@
 #include <cassert>
 #include <cmath>
 #include <cstring>
+#include <iomanip>
 #include <iterator>
 #include <optional>
 #include <ostream>
 #include <set>
+#include <sstream>
+#include <string>
 #include <utility>
 
 // Managing compiler warnings for SDL headers
@@ -62,6 +65,7 @@
 #endif
 
 #include "image_palette.h"
+#include "image_tool.h"
 #include "logging.h"
 #include "math_tools.h"
 #include "system.h"
@@ -262,6 +266,52 @@ namespace
         return true;
     }
 
+    // Returns the bounding area of all image pixels with colors marked in the given table.
+    fheroes2::Rect getColorsArea( const fheroes2::Image & image, const std::array<bool, fheroes2::paletteSize> & isColorMarked )
+    {
+        const int32_t width = image.width();
+        const int32_t height = image.height();
+
+        int32_t minX = width;
+        int32_t maxX = -1;
+        int32_t minY = -1;
+        int32_t maxY = -1;
+
+        const uint8_t * imageY = image.image();
+
+        for ( int32_t y = 0; y < height; ++y, imageY += width ) {
+            int32_t firstX = 0;
+            while ( firstX < width && !isColorMarked[imageY[firstX]] ) {
+                ++firstX;
+            }
+
+            if ( firstX == width ) {
+                continue;
+            }
+
+            if ( minY < 0 ) {
+                minY = y;
+            }
+
+            maxY = y;
+            minX = std::min( minX, firstX );
+
+            // There is no need to check pixels which are already within the area.
+            int32_t lastX = width - 1;
+            while ( lastX > maxX && !isColorMarked[imageY[lastX]] ) {
+                --lastX;
+            }
+
+            maxX = std::max( maxX, lastX );
+        }
+
+        if ( minY < 0 ) {
+            return {};
+        }
+
+        return { minX, minY, maxX - minX + 1, maxY - minY + 1 };
+    }
+
     const fheroes2::RGB * currentRGBPalette = RGBPalette();
 
 // If SDL library is used
@@ -1441,6 +1491,85 @@ namespace
         }
     };
 #endif
+
+    // This render engine does not create any window. Every frame stays in the memory of Display and optionally is saved as an image.
+    class OffscreenRenderEngine final : public fheroes2::BaseRenderEngine
+    {
+    public:
+        explicit OffscreenRenderEngine( std::string frameDumpDirectory )
+            : _frameDumpDirectory( std::move( frameDumpDirectory ) )
+        {
+            // Do nothing.
+        }
+
+        OffscreenRenderEngine( const OffscreenRenderEngine & ) = delete;
+        OffscreenRenderEngine & operator=( const OffscreenRenderEngine & ) = delete;
+
+        ~OffscreenRenderEngine() override = default;
+
+        std::vector<fheroes2::ResolutionInfo> getAvailableResolutions() const override
+        {
+            if ( _resolution.gameWidth <= 0 || _resolution.gameHeight <= 0 ) {
+                return {};
+            }
+
+            return { _resolution };
+        }
+
+        fheroes2::Rect getActiveWindowROI() const override
+        {
+            return { 0, 0, _resolution.screenWidth, _resolution.screenHeight };
+        }
+
+        fheroes2::Size getCurrentScreenResolution() const override
+        {
+            return { _resolution.screenWidth, _resolution.screenHeight };
+        }
+
+    protected:
+        void clear() override
+        {
+            _resolution = {};
+        }
+
+        void render( const fheroes2::Display & display, const fheroes2::Rect & /*unused*/ ) override
+        {
+            ++_frameId;
+
+            if ( _frameDumpDirectory.empty() ) {
+                return;
+            }
+
+            std::ostringstream os;
+            os << "frame_" << std::setw( 6 ) << std::setfill( '0' ) << _frameId << ".bmp";
+
+            const std::string path = System::concatPath( _frameDumpDirectory, os.str() );
+            if ( !fheroes2::Save( display, path ) ) {
+                ERROR_LOG( "Failed to save frame " << _frameId << " to " << path )
+            }
+        }
+
+        bool allocate( fheroes2::ResolutionInfo & resolutionInfo, bool /*unused*/ ) override
+        {
+            if ( resolutionInfo.gameWidth <= 0 || resolutionInfo.gameHeight <= 0 ) {
+                return false;
+            }
+
+            // There is no window so the image is never scaled.
+            resolutionInfo.screenWidth = resolutionInfo.gameWidth;
+            resolutionInfo.screenHeight = resolutionInfo.gameHeight;
+
+            _resolution = resolutionInfo;
+            return true;
+        }
+
+    private:
+        const std::string _frameDumpDirectory;
+
+        fheroes2::ResolutionInfo _resolution;
+
+        uint32_t _frameId{ 0 };
+    };
 }
 
 namespace fheroes2
@@ -1485,6 +1614,8 @@ namespace fheroes2
             clear();
         }
 
+        _renderedColorIds = StandardPaletteIndexes();
+
         Image::resize( info.gameWidth, info.gameHeight );
         Image::reset();
 
@@ -1506,6 +1637,23 @@ namespace fheroes2
         if ( !_engine->allocate( res, isFullScreen ) ) {
             clear();
         }
+
+        _renderedColorIds = StandardPaletteIndexes();
+    }
+
+    void Display::enableOffscreenRendering( std::string frameDumpDirectory )
+    {
+        if ( _engine ) {
+            _engine->clear();
+        }
+
+        _engine = std::make_unique<OffscreenRenderEngine>( std::move( frameDumpDirectory ) );
+
+        _renderSurface = nullptr;
+        _prevRoi = {};
+
+        // Resolution has to be set again to allocate the resources of the new engine.
+        clear();
     }
 
     void Display::setWindowPos( const Point point )
@@ -1574,12 +1722,17 @@ namespace fheroes2
         if ( _preprocessing ) {
             std::vector<uint8_t> palette;
             if ( _preprocessing( palette ) ) {
-                _engine->updatePalette( palette );
                 // when we change a palette for 8-bit image we unwillingly call render so we don't need to re-render the same frame again
                 updateImage = ( _renderSurface == nullptr );
+
+                // Only the pixels with colors changed by the pre-processing step need to be rendered again.
+                const Rect changedArea = updateImage ? _getChangedColorsArea( palette ) : Rect();
+
+                _engine->updatePalette( palette );
+                _renderedColorIds = std::move( palette );
+
                 if ( updateImage ) {
-                    // Pre-processing step is applied to the whole image so we forcefully render the full frame.
-                    _engine->render( *this, { 0, 0, width(), height() } );
+                    _engine->render( *this, getBoundaryRect( getBoundaryRect( roi, _prevRoi ), changedArea ) );
                     return;
                 }
             }
@@ -1591,6 +1744,27 @@ namespace fheroes2
         }
     }
 
+    Rect Display::_getChangedColorsArea( const std::vector<uint8_t> & colorIds ) const
+    {
+        if ( colorIds.size() != paletteSize || _renderedColorIds.size() != paletteSize ) {
+            return { 0, 0, width(), height() };
+        }
+
+        std::array<bool, paletteSize> isColorChanged{};
+        bool isAnyColorChanged = false;
+
+        for ( size_t i = 0; i < paletteSize; ++i ) {
+            isColorChanged[i] = ( colorIds[i] != _renderedColorIds[i] );
+            isAnyColorChanged = isAnyColorChanged || isColorChanged[i];
+        }
+
+        if ( !isAnyColorChanged ) {
+            return {};
+        }
+
+        return getColorsArea( *this, isColorChanged );
+    }
+
     uint8_t * Display::image()
     {
         return _renderSurface != nullptr ? _renderSurface : Image::image();
@@ -1622,7 +1796,8 @@ namespace fheroes2
 
         currentRGBPalette = ( palette == nullptr ) ? RGBPalette( forceDefaultPaletteUpdate ) : palette;
 
-        _engine->updatePalette( StandardPaletteIndexes() );
+        _renderedColorIds = StandardPaletteIndexes();
+        _engine->updatePalette( _renderedColorIds );
     }
 
     bool Cursor::isFocusActive()
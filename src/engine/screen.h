@@ -219,6 +219,11 @@ namespace fheroes2
 
         void setResolution( ResolutionInfo info );
 
+        // Replace the render engine by the one which does not create any window, e.g. for headless runs and benchmarks.
+        // Rendered frames are saved as images into the given directory if it is not empty.
+        // The resolution must be set again after calling this method.
+        void enableOffscreenRendering( std::string frameDumpDirectory );
+
         // Call this method only if you need to reset renderer to update its parameters (e.g. screen scaling).
         void resetRenderer();
 
@@ -273,6 +278,9 @@ namespace fheroes2
         // Previous area drawn on the screen.
         Rect _prevRoi;
 
+        // Color ids of the palette currently used by the render engine. They are used to find out which pixels are affected by a palette change.
+        mutable std::vector<uint8_t> _renderedColorIds;
+
         Size _screenSize;
 
         // Only for cases of direct drawing on rendered 8-bit image.
@@ -284,6 +292,9 @@ namespace fheroes2
         Display();
 
         void _renderFrame( const Rect & roi ) const; // prepare and render a frame
+
+        // Returns the area which contains all pixels with colors changed by the given color ids comparing to the currently used ones.
+        Rect _getChangedColorsArea( const std::vector<uint8_t> & colorIds ) const;
     };
 
     class Cursor
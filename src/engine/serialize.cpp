@@ -136,7 +136,7 @@ IStreamBase & IStreamBase::operator>>( std::string & v )
 {
     v.resize( get32() );
 
-    std::for_each( v.begin(), v.end(), [this]( char & item ) { item = get8(); } );
+    getRawTo( reinterpret_cast<uint8_t *>( v.data() ), v.size() );
 
     return *this;
 }
@@ -146,40 +146,30 @@ IStreamBase & IStreamBase::operator>>( fheroes2::Point & v )
     return *this >> v.x >> v.y;
 }
 
-void OStreamBase::put16( uint16_t v )
-{
-    bigendian() ? putBE16( v ) : putLE16( v );
-}
-
-void OStreamBase::put32( uint32_t v )
-{
-    bigendian() ? putBE32( v ) : putLE32( v );
-}
-
 OStreamBase & OStreamBase::operator<<( const bool v )
 {
-    put8( v );
+    put( v );
 
     return *this;
 }
 
 OStreamBase & OStreamBase::operator<<( const char v )
 {
-    put8( v );
+    put( v );
 
     return *this;
 }
 
 OStreamBase & OStreamBase::operator<<( const int8_t v )
 {
-    put8( static_cast<uint8_t>( v ) );
+    put( static_cast<uint8_t>( v ) );
 
     return *this;
 }
 
 OStreamBase & OStreamBase::operator<<( const uint8_t v )
 {
-    put8( v );
+    put( v );
 
     return *this;
 }
@@ -229,6 +219,8 @@ OStreamBase & OStreamBase::operator<<( const fheroes2::Point & v )
 
 RWStreamBuf::RWStreamBuf( const size_t size )
 {
+    _putCursor = &_itput;
+
     if ( size ) {
         reallocBuf( size );
     }
@@ -238,38 +230,79 @@ RWStreamBuf::RWStreamBuf( const size_t size )
 
 void RWStreamBuf::putBE16( uint16_t v )
 {
-    put8( v >> 8 );
-    put8( v & 0xFF );
+    if ( !reserveForPut( 2 ) ) {
+        return;
+    }
+
+    _itput[0] = static_cast<uint8_t>( v >> 8 );
+    _itput[1] = static_cast<uint8_t>( v & 0xFF );
+
+    _itput += 2;
 }
 
 void RWStreamBuf::putLE16( uint16_t v )
 {
-    put8( v & 0xFF );
-    put8( v >> 8 );
+    if ( !reserveForPut( 2 ) ) {
+        return;
+    }
+
+    _itput[0] = static_cast<uint8_t>( v & 0xFF );
+    _itput[1] = static_cast<uint8_t>( v >> 8 );
+
+    _itput += 2;
 }
 
 void RWStreamBuf::putBE32( uint32_t v )
 {
-    put8( v >> 24 );
-    put8( ( v >> 16 ) & 0xFF );
-    put8( ( v >> 8 ) & 0xFF );
-    put8( v & 0xFF );
+    if ( !reserveForPut( 4 ) ) {
+        return;
+    }
+
+    _itput[0] = static_cast<uint8_t>( v >> 24 );
+    _itput[1] = static_cast<uint8_t>( ( v >> 16 ) & 0xFF );
+    _itput[2] = static_cast<uint8_t>( ( v >> 8 ) & 0xFF );
+    _itput[3] = static_cast<uint8_t>( v & 0xFF );
+
+    _itput += 4;
 }
 
 void RWStreamBuf::putLE32( uint32_t v )
 {
-    put8( v & 0xFF );
-    put8( ( v >> 8 ) & 0xFF );
-    put8( ( v >> 16 ) & 0xFF );
-    put8( v >> 24 );
+    if ( !reserveForPut( 4 ) ) {
+        return;
+    }
+
+    _itput[0] = static_cast<uint8_t>( v & 0xFF );
+    _itput[1] = static_cast<uint8_t>( ( v >> 8 ) & 0xFF );
+    _itput[2] = static_cast<uint8_t>( ( v >> 16 ) & 0xFF );
+    _itput[3] = static_cast<uint8_t>( v >> 24 );
+
+    _itput += 4;
 }
 
 void RWStreamBuf::putRaw( const void * ptr, size_t size )
 {
-    if ( size == 0 ) {
+    if ( size == 0 || !reserveForPut( size ) ) {
         return;
     }
 
+    memcpy( _itput, ptr, size );
+
+    _itput = _itput + size;
+}
+
+void RWStreamBuf::put8( const uint8_t v )
+{
+    if ( !reserveForPut( 1 ) ) {
+        return;
+    }
+
+    *_itput = v;
+    ++_itput;
+}
+
+bool RWStreamBuf::reserveForPut( const size_t size )
+{
     if ( sizep() < size ) {
         if ( size < capacity() / 2 ) {
             reallocBuf( capacity() + capacity() / 2 );
@@ -281,27 +314,10 @@ void RWStreamBuf::putRaw( const void * ptr, size_t size )
 
     if ( sizep() < size ) {
         assert( 0 );
-        return;
+        return false;
     }
 
-    memcpy( _itput, ptr, size );
-
-    _itput = _itput + size;
-}
-
-void RWStreamBuf::put8( const uint8_t v )
-{
-    if ( sizep() < 1 ) {
-        reallocBuf( capacity() + capacity() / 2 );
-    }
-
-    if ( sizep() < 1 ) {
-        assert( 0 );
-        return;
-    }
-
-    *_itput = v;
-    ++_itput;
+    return true;
 }
 
 size_t RWStreamBuf::tellp() const
@@ -333,6 +349,8 @@ void RWStreamBuf::reallocBuf( size_t size )
         _itput = _itbeg;
         _itget = _itbeg;
 
+        _putEnd = _itend;
+
         return;
     }
 
@@ -353,6 +371,8 @@ void RWStreamBuf::reallocBuf( size_t size )
 
         _itbeg = _buf.get();
         _itend = _itbeg + size;
+
+        _putEnd = _itend;
     }
 }
 
@@ -366,6 +386,16 @@ ROStreamBuf::ROStreamBuf( const std::vector<uint8_t> & buf )
     setBigendian( IS_BIGENDIAN );
 }
 
+ROStreamBuf::ROStreamBuf( const uint8_t * data, const size_t size )
+{
+    _itbeg = data;
+    _itend = _itbeg + size;
+    _itget = _itbeg;
+    _itput = _itend;
+
+    setBigendian( IS_BIGENDIAN );
+}
+
 ROStreamBuf::ROStreamBuf( std::vector<uint8_t> && buf )
     : _buf( std::move( buf ) )
 {
@@ -548,6 +578,23 @@ void StreamFile::put8( const uint8_t v )
     putUint<uint8_t>( v );
 }
 
+void StreamFile::getRawTo( uint8_t * data, const size_t size )
+{
+    if ( !_file ) {
+        // Just like get8() does.
+        std::fill( data, data + size, static_cast<uint8_t>( 0 ) );
+
+        return;
+    }
+
+    const size_t sizeRead = std::fread( data, 1, size, _file.get() );
+    if ( sizeRead < size ) {
+        std::fill( data + sizeRead, data + size, static_cast<uint8_t>( 0 ) );
+
+        setFail();
+    }
+}
+
 uint16_t StreamFile::getBE16()
 {
     return be16toh( getUint<uint16_t>() );
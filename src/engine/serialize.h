@@ -28,6 +28,7 @@
 #include <cassert>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <iterator>
 #include <list>
 #include <map>
@@ -141,6 +142,20 @@ protected:
 
     void setFail( bool f );
 
+    // Values of these types are stored in a stream exactly as they are represented in memory, except for the byte order.
+    // Therefore, contiguous sequences of such values can be read and written in bulk.
+    template <typename Type>
+    static constexpr bool isBulkSerializable
+        = ( std::is_integral_v<Type> || std::is_enum_v<Type> ) && !std::is_same_v<Type, bool> && ( sizeof( Type ) == 1 || sizeof( Type ) == 2 || sizeof( Type ) == 4 );
+
+    // Reverses the byte order of every value in the given sequence of values of the given size.
+    static void swapByteOrder( uint8_t * data, const size_t count, const size_t valueSize )
+    {
+        for ( size_t i = 0; i < count; ++i, data += valueSize ) {
+            std::reverse( data, data + valueSize );
+        }
+    }
+
 private:
     enum : uint32_t
     {
@@ -232,7 +247,12 @@ public:
     {
         v.resize( get32() );
 
-        std::for_each( v.begin(), v.end(), [this]( auto & item ) { *this >> item; } );
+        if constexpr ( isBulkSerializable<Type> ) {
+            getBulk( v.data(), v.size() );
+        }
+        else {
+            std::for_each( v.begin(), v.end(), [this]( auto & item ) { *this >> item; } );
+        }
 
         return *this;
     }
@@ -293,7 +313,12 @@ public:
             return *this;
         }
 
-        std::for_each( v.begin(), v.end(), [this]( auto & item ) { *this >> item; } );
+        if constexpr ( isBulkSerializable<Type> ) {
+            getBulk( v.data(), v.size() );
+        }
+        else {
+            std::for_each( v.begin(), v.end(), [this]( auto & item ) { *this >> item; } );
+        }
 
         return *this;
     }
@@ -302,6 +327,31 @@ protected:
     IStreamBase() = default;
 
     virtual uint8_t get8() = 0;
+
+    // Reads the given number of bytes. If there is not enough data, the rest of bytes is filled with zeros and the failure flag is set,
+    // just like get8() does.
+    virtual void getRawTo( uint8_t * data, const size_t size )
+    {
+        for ( size_t i = 0; i < size; ++i ) {
+            data[i] = get8();
+        }
+    }
+
+    template <typename Type>
+    void getBulk( Type * data, const size_t count )
+    {
+        static_assert( isBulkSerializable<Type> );
+
+        uint8_t * bytes = reinterpret_cast<uint8_t *>( data );
+
+        getRawTo( bytes, count * sizeof( Type ) );
+
+        if constexpr ( sizeof( Type ) > 1 ) {
+            if ( bigendian() != IS_BIGENDIAN ) {
+                swapByteOrder( bytes, count, sizeof( Type ) );
+            }
+        }
+    }
 };
 
 // Interface that declares the methods needed to write to a stream
@@ -321,12 +371,25 @@ public:
 
     virtual void putRaw( const void *, size_t ) = 0;
 
-    void put16( uint16_t );
-    void put32( uint32_t );
+    void put16( const uint16_t v )
+    {
+        if ( !putToArea( static_cast<uint16_t>( bigendian() ? htobe16( v ) : htole16( v ) ) ) ) {
+            bigendian() ? putBE16( v ) : putLE16( v );
+        }
+    }
+
+    void put32( const uint32_t v )
+    {
+        if ( !putToArea( static_cast<uint32_t>( bigendian() ? htobe32( v ) : htole32( v ) ) ) ) {
+            bigendian() ? putBE32( v ) : putLE32( v );
+        }
+    }
 
     void put( const uint8_t ch )
     {
-        put8( ch );
+        if ( !putToArea( ch ) ) {
+            put8( ch );
+        }
     }
 
     OStreamBase & operator<<( const bool v );
@@ -371,7 +434,12 @@ public:
     {
         put32( static_cast<uint32_t>( v.size() ) );
 
-        std::for_each( v.begin(), v.end(), [this]( const auto & item ) { *this << item; } );
+        if constexpr ( isBulkSerializable<Type> ) {
+            putBulk( v.data(), v.size() );
+        }
+        else {
+            std::for_each( v.begin(), v.end(), [this]( const auto & item ) { *this << item; } );
+        }
 
         return *this;
     }
@@ -411,7 +479,12 @@ public:
     {
         put32( static_cast<uint32_t>( v.size() ) );
 
-        std::for_each( v.begin(), v.end(), [this]( const auto & item ) { *this << item; } );
+        if constexpr ( isBulkSerializable<Type> ) {
+            putBulk( v.data(), v.size() );
+        }
+        else {
+            std::for_each( v.begin(), v.end(), [this]( const auto & item ) { *this << item; } );
+        }
 
         return *this;
     }
@@ -420,6 +493,51 @@ protected:
     OStreamBase() = default;
 
     virtual void put8( const uint8_t ) = 0;
+
+    // Streams with an in-memory storage backend can expose the free space of their storage as a put area. Scalar values are written
+    // directly to this area without virtual calls while there is enough space in it, otherwise the virtual methods are called.
+    // '_putCursor' points to the current put position of the derived class and '_putEnd' is the end of the area.
+    uint8_t ** _putCursor{ nullptr };
+    const uint8_t * _putEnd{ nullptr };
+
+    template <typename Type>
+    void putBulk( const Type * data, const size_t count )
+    {
+        static_assert( isBulkSerializable<Type> );
+
+        if ( sizeof( Type ) == 1 || bigendian() == IS_BIGENDIAN ) {
+            putRaw( data, count * sizeof( Type ) );
+            return;
+        }
+
+        // The byte order of values is changed in portions to avoid memory allocations.
+        std::array<uint8_t, 1024> buffer;
+        constexpr size_t portionCount = buffer.size() / sizeof( Type );
+
+        for ( size_t offset = 0; offset < count; offset += portionCount ) {
+            const size_t currentCount = std::min( portionCount, count - offset );
+
+            std::memcpy( buffer.data(), data + offset, currentCount * sizeof( Type ) );
+            swapByteOrder( buffer.data(), currentCount, sizeof( Type ) );
+
+            putRaw( buffer.data(), currentCount * sizeof( Type ) );
+        }
+    }
+
+private:
+    // Writes the given value as is to the put area if there is enough space in it. Returns false otherwise.
+    template <typename Type>
+    bool putToArea( const Type v )
+    {
+        if ( _putCursor == nullptr || static_cast<size_t>( _putEnd - *_putCursor ) < sizeof( Type ) ) {
+            return false;
+        }
+
+        std::memcpy( *_putCursor, &v, sizeof( Type ) );
+        *_putCursor += sizeof( Type );
+
+        return true;
+    }
 };
 
 // Interface that declares a stream with an in-memory storage backend that can be read from
@@ -475,6 +593,15 @@ public:
 
     uint16_t getBE16() override
     {
+        if ( sizeg() >= 2 ) {
+            const uint16_t v = static_cast<uint16_t>( ( static_cast<uint16_t>( _itget[0] ) << 8 ) | _itget[1] );
+
+            _itget += 2;
+
+            return v;
+        }
+
+        // If there is not enough data, it is read byte by byte to handle the failure in the same way as get8() does.
         uint16_t v = ( static_cast<uint16_t>( get8() ) << 8 );
 
         v |= get8();
@@ -484,6 +611,14 @@ public:
 
     uint16_t getLE16() override
     {
+        if ( sizeg() >= 2 ) {
+            const uint16_t v = static_cast<uint16_t>( _itget[0] | ( static_cast<uint16_t>( _itget[1] ) << 8 ) );
+
+            _itget += 2;
+
+            return v;
+        }
+
         uint16_t v = get8();
 
         v |= ( static_cast<uint16_t>( get8() ) << 8 );
@@ -493,6 +628,15 @@ public:
 
     uint32_t getBE32() override
     {
+        if ( sizeg() >= 4 ) {
+            const uint32_t v
+                = ( static_cast<uint32_t>( _itget[0] ) << 24 ) | ( static_cast<uint32_t>( _itget[1] ) << 16 ) | ( static_cast<uint32_t>( _itget[2] ) << 8 ) | _itget[3];
+
+            _itget += 4;
+
+            return v;
+        }
+
         uint32_t v = ( static_cast<uint32_t>( get8() ) << 24 );
 
         v |= ( static_cast<uint32_t>( get8() ) << 16 );
@@ -504,6 +648,15 @@ public:
 
     uint32_t getLE32() override
     {
+        if ( sizeg() >= 4 ) {
+            const uint32_t v
+                = _itget[0] | ( static_cast<uint32_t>( _itget[1] ) << 8 ) | ( static_cast<uint32_t>( _itget[2] ) << 16 ) | ( static_cast<uint32_t>( _itget[3] ) << 24 );
+
+            _itget += 4;
+
+            return v;
+        }
+
         uint32_t v = get8();
 
         v |= ( static_cast<uint32_t>( get8() ) << 8 );
@@ -571,6 +724,21 @@ protected:
         return 0;
     }
 
+    void getRawTo( uint8_t * data, const size_t size ) override
+    {
+        const size_t sizeToCopy = std::min( size, sizeg() );
+
+        std::copy( _itget, _itget + sizeToCopy, data );
+
+        _itget += sizeToCopy;
+
+        if ( sizeToCopy < size ) {
+            std::fill( data + sizeToCopy, data + size, static_cast<uint8_t>( 0 ) );
+
+            setFail();
+        }
+    }
+
     size_t capacity() const
     {
         assert( _itbeg <= _itend );
@@ -610,6 +778,9 @@ public:
 private:
     void put8( const uint8_t v ) override;
 
+    // Makes sure that there is enough space to put the given number of bytes, expanding the buffer if necessary.
+    bool reserveForPut( const size_t size );
+
     size_t sizep() const;
     size_t tellp() const;
 
@@ -618,6 +789,61 @@ private:
     std::unique_ptr<uint8_t[]> _buf;
 };
 
+// Stream which does not store any data but only counts the number of bytes put into it. It is used to find out the exact
+// size of serialized data, e.g. to allocate the memory for RWStreamBuf in advance.
+class StreamSizeCounter final : public OStreamBase
+{
+public:
+    StreamSizeCounter()
+    {
+        setBigendian( IS_BIGENDIAN );
+    }
+
+    StreamSizeCounter( const StreamSizeCounter & ) = delete;
+
+    ~StreamSizeCounter() override = default;
+
+    StreamSizeCounter & operator=( const StreamSizeCounter & ) = delete;
+
+    void putBE32( uint32_t /* unused */ ) override
+    {
+        _size += 4;
+    }
+
+    void putLE32( uint32_t /* unused */ ) override
+    {
+        _size += 4;
+    }
+
+    void putBE16( uint16_t /* unused */ ) override
+    {
+        _size += 2;
+    }
+
+    void putLE16( uint16_t /* unused */ ) override
+    {
+        _size += 2;
+    }
+
+    void putRaw( const void * /* unused */, size_t size ) override
+    {
+        _size += size;
+    }
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+private:
+    void put8( const uint8_t /* unused */ ) override
+    {
+        ++_size;
+    }
+
+    size_t _size{ 0 };
+};
+
 // Stream with read-only in-memory storage backed by a const vector instance (either internal or external, depending on the constructor used)
 class ROStreamBuf final : public StreamBufTmpl<const uint8_t>
 {
@@ -626,6 +852,8 @@ public:
     explicit ROStreamBuf( const std::vector<uint8_t> & buf );
     // Takes ownership of the given buffer (through the move operation) and creates a stream on top of it
     explicit ROStreamBuf( std::vector<uint8_t> && buf );
+    // Creates a non-owning stream on top of an external memory block ("view mode")
+    ROStreamBuf( const uint8_t * data, const size_t size );
 
     ROStreamBuf( const ROStreamBuf & ) = delete;
 
@@ -699,6 +927,8 @@ private:
     uint8_t get8() override;
     void put8( const uint8_t v ) override;
 
+    void getRawTo( uint8_t * data, const size_t size ) override;
+
     template <typename T>
     T getUint()
     {
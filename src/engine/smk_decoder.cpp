@@ -21,12 +21,12 @@
 #include "smk_decoder.h"
 
 #include <algorithm>
-#include <array>
 #include <cassert>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <ostream>
+#include <utility>
 
 #include "exception.h"
 #include "image.h"
@@ -65,18 +65,13 @@ SMKVideoSequence::SMKVideoSequence( const std::string & filePath )
 {
     verifyVideoFile( filePath );
 
-    _videoFile.reset( smk_open_file( filePath.c_str(), SMK_MODE_MEMORY ) );
+    // Frames are read from the file on demand so only one frame is being kept in memory.
+    _videoFile.reset( smk_open_file( filePath.c_str(), SMK_MODE_DISK ) );
     if ( !_videoFile ) {
         return;
     }
 
-    const uint8_t audioChannelCount = 7;
-
-    uint8_t trackMask = 0;
-    uint8_t channelsPerTrack[audioChannelCount] = { 0 };
-    uint8_t audioBitDepth[audioChannelCount] = { 0 };
-    unsigned long audioRate[audioChannelCount] = { 0 };
-    std::array<std::vector<uint8_t>, audioChannelCount> soundBuffer;
+    _filePath = filePath;
 
     unsigned long width = 0;
     unsigned long height = 0;
@@ -104,122 +99,178 @@ SMKVideoSequence::SMKVideoSequence( const std::string & filePath )
     _width = static_cast<int32_t>( width );
     _height = static_cast<int32_t>( height ) * _heightScaleFactor;
 
-    if ( const signed char returnValue = smk_info_audio( _videoFile.get(), &trackMask, channelsPerTrack, audioBitDepth, audioRate ); returnValue < 0 ) {
-        ERROR_LOG( "smk_info_audio() failed with error code: " << static_cast<int>( returnValue ) )
-    }
-
     if ( _microsecondsPerFrame < 1 ) {
         // Since the value is not set let's set a default value for 15 FPS.
         _microsecondsPerFrame = 1000000.0 / 15.0;
     }
 
+    // Audio is decoded separately only when it is requested, so there is no need to decode audio data of video frames.
+    const uint8_t audioChannelCount = 7;
+
     for ( uint8_t i = 0; i < audioChannelCount; ++i ) {
-        if ( trackMask & ( 1 << i ) ) {
-            if ( const signed char returnValue = smk_enable_audio( _videoFile.get(), i, 1 ); returnValue < 0 ) {
-                ERROR_LOG( "smk_enable_audio() failed with error code: " << static_cast<int>( returnValue ) )
-            }
+        if ( const signed char returnValue = smk_enable_audio( _videoFile.get(), i, 0 ); returnValue < 0 ) {
+            ERROR_LOG( "smk_enable_audio() failed with error code: " << static_cast<int>( returnValue ) )
         }
     }
 
-    // Disable video reading.
-    if ( const signed char returnValue = smk_enable_video( _videoFile.get(), 0 ); returnValue < 0 ) {
-        ERROR_LOG( "smk_enable_video() failed with error code: " << static_cast<int>( returnValue ) )
-    }
-
     if ( const signed char returnValue = smk_first( _videoFile.get() ); returnValue < 0 ) {
         ERROR_LOG( "smk_first() failed with error code: " << static_cast<int>( returnValue ) )
     }
+}
 
-    unsigned long currentFrame = 0;
+const std::vector<std::vector<uint8_t>> & SMKVideoSequence::getAudioChannels()
+{
+    if ( !_isAudioLoaded ) {
+        _isAudioLoaded = true;
 
-    if ( const signed char returnValue = smk_info_all( _videoFile.get(), &currentFrame, nullptr, nullptr ); returnValue < 0 ) {
-        ERROR_LOG( "smk_info_all() failed with error code: " << static_cast<int>( returnValue ) )
+        _loadAudio();
     }
 
-    for ( uint8_t i = 0; i < audioChannelCount; ++i ) {
-        if ( trackMask & ( 1 << i ) ) {
-            const unsigned long length = smk_get_audio_size( _videoFile.get(), i );
-            if ( length == 0 ) {
-                continue;
-            }
+    return _audioChannel;
+}
 
-            if ( soundBuffer[i].empty() ) {
-                soundBuffer[i].resize( audioHeaderSize );
-            }
+bool SMKVideoSequence::resetAudio()
+{
+    _currentAudioFrameId = 0;
 
-            const uint8_t * data = smk_get_audio( _videoFile.get(), i );
-            soundBuffer[i].insert( soundBuffer[i].end(), data, data + length );
+    if ( !_audioFile ) {
+        if ( _filePath.empty() ) {
+            return false;
         }
-    }
 
-    for ( currentFrame = 1; currentFrame < _frameCount; ++currentFrame ) {
-        if ( const signed char returnValue = smk_next( _videoFile.get() ); returnValue < 0 ) {
-            ERROR_LOG( "smk_next() failed with error code: " << static_cast<int>( returnValue ) )
+        _audioFile.reset( smk_open_file( _filePath.c_str(), SMK_MODE_DISK ) );
+        if ( !_audioFile ) {
+            return false;
+        }
+
+        const uint8_t audioChannelCount = 7;
+
+        uint8_t trackMask = 0;
+        uint8_t channelsPerTrack[audioChannelCount] = { 0 };
+        uint8_t audioBitDepth[audioChannelCount] = { 0 };
+        unsigned long audioRate[audioChannelCount] = { 0 };
+
+        if ( const signed char returnValue = smk_info_audio( _audioFile.get(), &trackMask, channelsPerTrack, audioBitDepth, audioRate ); returnValue < 0 ) {
+            ERROR_LOG( "smk_info_audio() failed with error code: " << static_cast<int>( returnValue ) )
         }
 
+        _audioTracks.clear();
+        _audioTrackIds.clear();
+
         for ( uint8_t i = 0; i < audioChannelCount; ++i ) {
             if ( trackMask & ( 1 << i ) ) {
-                const unsigned long length = smk_get_audio_size( _videoFile.get(), i );
-                if ( length == 0 ) {
-                    continue;
-                }
-
-                if ( soundBuffer[i].empty() ) {
-                    soundBuffer[i].resize( audioHeaderSize );
+                if ( const signed char returnValue = smk_enable_audio( _audioFile.get(), i, 1 ); returnValue < 0 ) {
+                    ERROR_LOG( "smk_enable_audio() failed with error code: " << static_cast<int>( returnValue ) )
                 }
 
-                const uint8_t * data = smk_get_audio( _videoFile.get(), i );
-                soundBuffer[i].insert( soundBuffer[i].end(), data, data + length );
+                _audioTracks.push_back( { static_cast<uint32_t>( audioRate[i] ), audioBitDepth[i], channelsPerTrack[i] } );
+                _audioTrackIds.push_back( i );
             }
         }
+
+        // Disable video reading.
+        if ( const signed char returnValue = smk_enable_video( _audioFile.get(), 0 ); returnValue < 0 ) {
+            ERROR_LOG( "smk_enable_video() failed with error code: " << static_cast<int>( returnValue ) )
+        }
     }
 
-    size_t channelCount = 0;
-    for ( size_t i = 0; i < soundBuffer.size(); ++i ) {
-        if ( !soundBuffer[i].empty() ) {
-            ++channelCount;
+    if ( _audioTracks.empty() ) {
+        // There is no audio in this video.
+        return false;
+    }
+
+    if ( const signed char returnValue = smk_first( _audioFile.get() ); returnValue < 0 ) {
+        ERROR_LOG( "smk_first() failed with error code: " << static_cast<int>( returnValue ) )
+    }
+
+    return true;
+}
+
+bool SMKVideoSequence::getNextAudioFrame( std::vector<std::vector<uint8_t>> & audioData )
+{
+    if ( !_audioFile || _currentAudioFrameId >= _frameCount ) {
+        return false;
+    }
+
+    // The first frame is read by smk_first().
+    if ( _currentAudioFrameId > 0 ) {
+        if ( const signed char returnValue = smk_next( _audioFile.get() ); returnValue < 0 ) {
+            ERROR_LOG( "smk_next() failed with error code: " << static_cast<int>( returnValue ) )
         }
     }
-    _audioChannel.resize( channelCount );
 
-    channelCount = 0;
+    audioData.resize( _audioTrackIds.size() );
 
-    // Compose the soundtrack
-    for ( size_t i = 0; i < soundBuffer.size(); ++i ) {
-        if ( !soundBuffer[i].empty() ) {
-            std::vector<uint8_t> & wavData = _audioChannel[channelCount];
-            std::swap( wavData, soundBuffer[i] );
-
-            const uint32_t originalSize = static_cast<uint32_t>( wavData.size() - audioHeaderSize );
-
-            ++channelCount;
-
-            RWStreamBuf wavHeader( audioHeaderSize );
-            wavHeader.putLE32( 0x46464952 ); // RIFF marker ("RIFF")
-            wavHeader.putLE32( originalSize + 0x24 ); // Total size minus the size of this and previous fields
-            wavHeader.putLE32( 0x45564157 ); // File type header ("WAVE")
-            wavHeader.putLE32( 0x20746D66 ); // Format sub-chunk marker ("fmt ")
-            wavHeader.putLE32( 0x10 ); // Size of the format sub-chunk
-            wavHeader.putLE16( 0x01 ); // Audio format (1 for PCM)
-            wavHeader.putLE16( channelsPerTrack[i] ); // Number of channels
-            wavHeader.putLE32( audioRate[i] ); // Sample rate
-            wavHeader.putLE32( audioRate[i] * audioBitDepth[i] * channelsPerTrack[i] / 8 ); // Byte rate
-            wavHeader.putLE16( audioBitDepth[i] * channelsPerTrack[i] / 8 ); // Block align
-            wavHeader.putLE16( audioBitDepth[i] ); // Bits per sample
-            wavHeader.putLE32( 0x61746164 ); // Data sub-chunk marker ("data")
-            wavHeader.putLE32( originalSize ); // Size of the data sub-chunk
-
-            memcpy( wavData.data(), wavHeader.data(), audioHeaderSize );
+    for ( size_t i = 0; i < _audioTrackIds.size(); ++i ) {
+        const unsigned long length = smk_get_audio_size( _audioFile.get(), _audioTrackIds[i] );
+        const uint8_t * data = smk_get_audio( _audioFile.get(), _audioTrackIds[i] );
+
+        if ( length == 0 || data == nullptr ) {
+            audioData[i].clear();
         }
+        else {
+            audioData[i].assign( data, data + length );
+        }
+    }
+
+    ++_currentAudioFrameId;
+
+    return true;
+}
+
+void SMKVideoSequence::_loadAudio()
+{
+    if ( !resetAudio() ) {
+        return;
     }
 
-    // Enable video reading.
-    if ( const signed char returnValue = smk_enable_video( _videoFile.get(), 1 ); returnValue < 0 ) {
-        ERROR_LOG( "smk_enable_video() failed with error code: " << static_cast<int>( returnValue ) )
+    std::vector<std::vector<uint8_t>> soundBuffer( _audioTracks.size() );
+    std::vector<std::vector<uint8_t>> frameAudioData;
+
+    while ( getNextAudioFrame( frameAudioData ) ) {
+        for ( size_t i = 0; i < frameAudioData.size(); ++i ) {
+            if ( frameAudioData[i].empty() ) {
+                continue;
+            }
+
+            if ( soundBuffer[i].empty() ) {
+                soundBuffer[i].resize( audioHeaderSize );
+            }
+
+            soundBuffer[i].insert( soundBuffer[i].end(), frameAudioData[i].begin(), frameAudioData[i].end() );
+        }
     }
 
-    if ( const signed char returnValue = smk_first( _videoFile.get() ); returnValue < 0 ) {
-        ERROR_LOG( "smk_first() failed with error code: " << static_cast<int>( returnValue ) )
+    // The whole audio has been read, so there is no need to keep the file open.
+    _audioFile.reset();
+
+    // Compose the soundtrack
+    for ( size_t i = 0; i < soundBuffer.size(); ++i ) {
+        if ( soundBuffer[i].empty() ) {
+            continue;
+        }
+
+        std::vector<uint8_t> & wavData = _audioChannel.emplace_back( std::move( soundBuffer[i] ) );
+
+        const AudioTrackInfo & track = _audioTracks[i];
+        const uint32_t originalSize = static_cast<uint32_t>( wavData.size() - audioHeaderSize );
+
+        RWStreamBuf wavHeader( audioHeaderSize );
+        wavHeader.putLE32( 0x46464952 ); // RIFF marker ("RIFF")
+        wavHeader.putLE32( originalSize + 0x24 ); // Total size minus the size of this and previous fields
+        wavHeader.putLE32( 0x45564157 ); // File type header ("WAVE")
+        wavHeader.putLE32( 0x20746D66 ); // Format sub-chunk marker ("fmt ")
+        wavHeader.putLE32( 0x10 ); // Size of the format sub-chunk
+        wavHeader.putLE16( 0x01 ); // Audio format (1 for PCM)
+        wavHeader.putLE16( track.channelCount ); // Number of channels
+        wavHeader.putLE32( track.sampleRate ); // Sample rate
+        wavHeader.putLE32( track.sampleRate * track.bitsPerSample * track.channelCount / 8 ); // Byte rate
+        wavHeader.putLE16( static_cast<uint16_t>( track.bitsPerSample * track.channelCount / 8 ) ); // Block align
+        wavHeader.putLE16( track.bitsPerSample ); // Bits per sample
+        wavHeader.putLE32( 0x61746164 ); // Data sub-chunk marker ("data")
+        wavHeader.putLE32( originalSize ); // Size of the data sub-chunk
+
+        memcpy( wavData.data(), wavHeader.data(), audioHeaderSize );
     }
 }
 
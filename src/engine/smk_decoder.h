@@ -35,6 +35,13 @@ namespace fheroes2
 class SMKVideoSequence final
 {
 public:
+    struct AudioTrackInfo
+    {
+        uint32_t sampleRate{ 0 };
+        uint8_t bitsPerSample{ 0 };
+        uint8_t channelCount{ 0 };
+    };
+
     explicit SMKVideoSequence( const std::string & filePath );
     ~SMKVideoSequence() = default;
 
@@ -59,9 +66,25 @@ public:
 
     std::vector<uint8_t> getCurrentPalette() const;
 
-    const std::vector<std::vector<uint8_t>> & getAudioChannels() const
+    // Audio data is decoded on the first call of this method.
+    const std::vector<std::vector<uint8_t>> & getAudioChannels();
+
+    // Audio is read frame by frame from a separate instance of the video file, so the current video frame is not affected.
+    // This method rewinds the audio to the first frame. Returns false if there is no audio in the video.
+    bool resetAudio();
+
+    // Parameters of audio tracks are known only after a call of resetAudio().
+    const std::vector<AudioTrackInfo> & getAudioTracks() const
+    {
+        return _audioTracks;
+    }
+
+    // Reads audio data of the next frame for every audio track. Returns false if there are no frames left.
+    bool getNextAudioFrame( std::vector<std::vector<uint8_t>> & audioData );
+
+    unsigned long getCurrentAudioFrameId() const
     {
-        return _audioChannel;
+        return _currentAudioFrameId;
     }
 
     int32_t width() const
@@ -90,6 +113,7 @@ public:
     }
 
 private:
+    std::string _filePath;
     std::vector<std::vector<uint8_t>> _audioChannel;
     int32_t _width{ 0 };
     int32_t _height{ 0 };
@@ -97,6 +121,14 @@ private:
     double _microsecondsPerFrame{ 0 };
     unsigned long _frameCount{ 0 };
     unsigned long _currentFrameId{ 0 };
+    unsigned long _currentAudioFrameId{ 0 };
+    bool _isAudioLoaded{ false };
+
+    std::vector<AudioTrackInfo> _audioTracks;
+    std::vector<uint8_t> _audioTrackIds;
 
     std::unique_ptr<struct smk_t, void ( * )( struct smk_t * )> _videoFile{ nullptr, smk_close };
+    std::unique_ptr<struct smk_t, void ( * )( struct smk_t * )> _audioFile{ nullptr, smk_close };
+
+    void _loadAudio();
 };
@@ -448,6 +448,33 @@ bool System::IsDirectory( const std::string_view path )
     return std::filesystem::is_directory( correctedPath, ec );
 }
 
+bool System::getFileSizeAndModificationTime( const std::string_view path, uint64_t & fileSize, int64_t & modificationTime )
+{
+    if ( path.empty() ) {
+        return false;
+    }
+
+    const std::filesystem::path fsPath( path );
+
+    // Using the non-throwing overloads
+    std::error_code ec;
+
+    const std::uintmax_t size = std::filesystem::file_size( fsPath, ec );
+    if ( ec ) {
+        return false;
+    }
+
+    const std::filesystem::file_time_type time = std::filesystem::last_write_time( fsPath, ec );
+    if ( ec ) {
+        return false;
+    }
+
+    fileSize = static_cast<uint64_t>( size );
+    modificationTime = static_cast<int64_t>( time.time_since_epoch().count() );
+
+    return true;
+}
+
 bool System::GetCaseInsensitivePath( const std::string_view path, std::string & correctedPath )
 {
 #if !defined( _WIN32 ) && !defined( ANDROID ) && !defined( TARGET_PS_VITA ) && !defined( __IPHONEOS__ )
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <ctime>
 #include <filesystem>
 #include <string>
@@ -64,6 +65,10 @@ namespace System
     bool IsFile( const std::string_view path );
     bool IsDirectory( const std::string_view path );
 
+    // Gets the size and the time of the last modification of the given file. The modification time is returned as an opaque value
+    // which can only be compared with another value returned by this function. Returns false if the file does not exist.
+    bool getFileSizeAndModificationTime( const std::string_view path, uint64_t & fileSize, int64_t & modificationTime );
+
     bool GetCaseInsensitivePath( const std::string_view path, std::string & correctedPath );
 
     // Resolves the wildcard pattern 'glob' and appends matching paths to 'fileNames'. Supported wildcards are '?' and '*'.
@@ -20,6 +20,7 @@
 
 #include "thread.h"
 
+#include <algorithm>
 #include <cassert>
 #include <memory>
 
@@ -150,4 +151,123 @@ namespace MultiThreading
             manager->executeTask();
         }
     }
+
+    ThreadPool::ThreadPool( const size_t workerCount /* = 0 */ )
+    {
+#if !defined( __EMSCRIPTEN__ ) || defined( __EMSCRIPTEN_PTHREADS__ )
+        const size_t count = ( workerCount > 0 ) ? workerCount : std::max( std::thread::hardware_concurrency(), 1U ) - 1;
+
+        _workers.reserve( count );
+
+        for ( size_t i = 0; i < count; ++i ) {
+            _workers.emplace_back( ThreadPool::_workerThread, this );
+        }
+#else
+        (void)workerCount;
+#endif
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            _exitFlag = true;
+        }
+
+        _workerNotification.notify_all();
+
+        for ( std::thread & worker : _workers ) {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::run( const size_t count, const std::function<void( size_t )> & function )
+    {
+        if ( count == 0 ) {
+            return;
+        }
+
+        if ( _workers.empty() || count == 1 ) {
+            for ( size_t i = 0; i < count; ++i ) {
+                function( i );
+            }
+
+            return;
+        }
+
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            assert( _busyWorkerCount == 0 );
+
+            _function = &function;
+            _taskCount = count;
+            _nextTask = 0;
+            _busyWorkerCount = _workers.size();
+
+            ++_generation;
+        }
+
+        _workerNotification.notify_all();
+
+        // The calling thread does its part of the work as well.
+        _processTasks();
+
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+
+            _masterNotification.wait( lock, [this] { return _busyWorkerCount == 0; } );
+
+            _function = nullptr;
+            _taskCount = 0;
+        }
+    }
+
+    void ThreadPool::_processTasks()
+    {
+        assert( _function != nullptr );
+
+        for ( size_t i = _nextTask++; i < _taskCount; i = _nextTask++ ) {
+            ( *_function )( i );
+        }
+    }
+
+    void ThreadPool::_workerThread( ThreadPool * pool )
+    {
+        assert( pool != nullptr );
+
+        uint64_t lastGeneration = 0;
+
+        while ( true ) {
+            {
+                std::unique_lock<std::mutex> lock( pool->_mutex );
+
+                pool->_workerNotification.wait( lock, [pool, lastGeneration] { return pool->_exitFlag || pool->_generation != lastGeneration; } );
+
+                if ( pool->_exitFlag ) {
+                    break;
+                }
+
+                lastGeneration = pool->_generation;
+            }
+
+            pool->_processTasks();
+
+            bool isLastWorker = false;
+
+            {
+                const std::scoped_lock<std::mutex> lock( pool->_mutex );
+
+                assert( pool->_busyWorkerCount > 0 );
+
+                --pool->_busyWorkerCount;
+                isLastWorker = ( pool->_busyWorkerCount == 0 );
+            }
+
+            if ( isLastWorker ) {
+                pool->_masterNotification.notify_one();
+            }
+        }
+    }
 }
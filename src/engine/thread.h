@@ -22,9 +22,13 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 namespace MultiThreading
 {
@@ -70,4 +74,46 @@ namespace MultiThreading
 
         static void _workerThread( AsyncManager * manager );
     };
+
+    // A pool of worker threads to process a set of independent tasks in parallel. Tasks are not assigned to
+    // threads in advance: every thread (including the calling one) takes the next unprocessed task until there
+    // are no more tasks left, so a thread that got cheaper tasks simply processes more of them.
+    class ThreadPool
+    {
+    public:
+        // Creates the given number of worker threads. If 0 is specified, then the number of worker threads
+        // is one less than the number of hardware threads, as the calling thread is also used.
+        explicit ThreadPool( const size_t workerCount = 0 );
+        ThreadPool( const ThreadPool & ) = delete;
+
+        ~ThreadPool();
+
+        ThreadPool & operator=( const ThreadPool & ) = delete;
+
+        // Calls the given function for each index in range [0, count) and waits until all calls are completed.
+        // The calls are made in no particular order and the function must not throw any exceptions. This method
+        // is not designed to be executed concurrently.
+        void run( const size_t count, const std::function<void( size_t )> & function );
+
+    private:
+        std::vector<std::thread> _workers;
+
+        std::mutex _mutex;
+        std::condition_variable _masterNotification;
+        std::condition_variable _workerNotification;
+
+        // The current set of tasks. These members are modified only while all worker threads are idle.
+        const std::function<void( size_t )> * _function{ nullptr };
+        size_t _taskCount{ 0 };
+        std::atomic<size_t> _nextTask{ 0 };
+
+        // Incremented for every new set of tasks to wake up the worker threads.
+        uint64_t _generation{ 0 };
+        size_t _busyWorkerCount{ 0 };
+        bool _exitFlag{ false };
+
+        void _processTasks();
+
+        static void _workerThread( ThreadPool * pool );
+    };
 }
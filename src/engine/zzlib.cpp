@@ -23,18 +23,64 @@
 
 #include "zzlib.h"
 
+#include <cassert>
 #include <cstring>
 #include <ostream>
 
 #include <zconf.h>
 #include <zlib.h>
 
+#include "fast_lz.h"
 #include "logging.h"
 #include "serialize.h"
 
 namespace
 {
-    constexpr uint16_t FORMAT_VERSION_0 = 0;
+    // Each block of the fast LZ format starts with the unzipped and zipped sizes of the block.
+    const size_t fastLzBlockHeaderSize{ 8 };
+
+    void writeLE32( std::vector<uint8_t> & output, const uint32_t value )
+    {
+        output.push_back( static_cast<uint8_t>( value & 0xFF ) );
+        output.push_back( static_cast<uint8_t>( ( value >> 8 ) & 0xFF ) );
+        output.push_back( static_cast<uint8_t>( ( value >> 16 ) & 0xFF ) );
+        output.push_back( static_cast<uint8_t>( value >> 24 ) );
+    }
+
+    uint32_t readLE32( const uint8_t * data )
+    {
+        return static_cast<uint32_t>( data[0] ) | ( static_cast<uint32_t>( data[1] ) << 8 ) | ( static_cast<uint32_t>( data[2] ) << 16 )
+               | ( static_cast<uint32_t>( data[3] ) << 24 );
+    }
+
+    bool unzipFastLzBlocks( const std::vector<uint8_t> & zip, std::vector<uint8_t> & raw )
+    {
+        size_t zipPos = 0;
+        size_t rawPos = 0;
+
+        while ( zipPos < zip.size() ) {
+            if ( zip.size() - zipPos < fastLzBlockHeaderSize ) {
+                return false;
+            }
+
+            const uint32_t blockRawSize = readLE32( zip.data() + zipPos );
+            const uint32_t blockZipSize = readLE32( zip.data() + zipPos + 4 );
+            zipPos += fastLzBlockHeaderSize;
+
+            if ( blockZipSize > zip.size() - zipPos || blockRawSize > raw.size() - rawPos ) {
+                return false;
+            }
+
+            if ( !Compression::fastUnzipBlock( zip.data() + zipPos, blockZipSize, raw.data() + rawPos, blockRawSize ) ) {
+                return false;
+            }
+
+            zipPos += blockZipSize;
+            rawPos += blockRawSize;
+        }
+
+        return rawPos == raw.size();
+    }
 }
 
 std::vector<uint8_t> Compression::unzipData( const uint8_t * src, const size_t srcSize, size_t realSize /* = 0 */ )
@@ -167,16 +213,35 @@ bool Compression::unzipStream( IStreamBase & inputStream, OStreamBase & outputSt
         return false;
     }
 
-    const uint16_t version = inputStream.get16();
-    if ( version != FORMAT_VERSION_0 ) {
-        return false;
-    }
+    const uint16_t format = inputStream.get16();
 
     inputStream.skip( 2 ); // Unused bytes
 
-    const std::vector<uint8_t> zip = inputStream.getRaw( zipSize );
-    const std::vector<uint8_t> raw = unzipData( zip.data(), zip.size(), rawSize );
-    if ( raw.size() != rawSize ) {
+    std::vector<uint8_t> raw;
+
+    switch ( static_cast<StreamFormat>( format ) ) {
+    case StreamFormat::ZLIB: {
+        const std::vector<uint8_t> zip = inputStream.getRaw( zipSize );
+        raw = unzipData( zip.data(), zip.size(), rawSize );
+        if ( raw.size() != rawSize ) {
+            return false;
+        }
+        break;
+    }
+    case StreamFormat::FAST_LZ: {
+        const std::vector<uint8_t> zip = inputStream.getRaw( zipSize );
+        if ( zip.size() != zipSize ) {
+            return false;
+        }
+
+        raw.resize( rawSize );
+        if ( !unzipFastLzBlocks( zip, raw ) ) {
+            ERROR_LOG( "The fast LZ data is corrupted" )
+            return false;
+        }
+        break;
+    }
+    default:
         return false;
     }
 
@@ -192,15 +257,121 @@ bool Compression::zipStreamBuf( const IStreamBuf & inputStream, OStreamBase & ou
         return false;
     }
 
-    outputStream.put32( static_cast<uint32_t>( inputStream.size() ) );
-    outputStream.put32( static_cast<uint32_t>( zip.size() ) );
-    outputStream.put16( FORMAT_VERSION_0 );
-    outputStream.put16( 0 ); // Unused bytes
+    writeZipStreamHeader( outputStream, static_cast<uint32_t>( inputStream.size() ), static_cast<uint32_t>( zip.size() ) );
     outputStream.putRaw( zip.data(), zip.size() );
 
     return !outputStream.fail();
 }
 
+void Compression::writeZipStreamHeader( OStreamBase & outputStream, const uint32_t rawSize, const uint32_t zipSize, const StreamFormat format /* = ZLIB */ )
+{
+    outputStream.put32( rawSize );
+    outputStream.put32( zipSize );
+    outputStream.put16( static_cast<uint16_t>( format ) );
+    outputStream.put16( 0 ); // Unused bytes
+}
+
+Compression::StreamZipper::StreamZipper( const StreamFormat format /* = ZLIB */ )
+    : _format( format )
+{
+    if ( _format != StreamFormat::ZLIB ) {
+        return;
+    }
+
+    _stream = std::make_unique<z_stream>();
+
+    const int ret = deflateInit( _stream.get(), Z_DEFAULT_COMPRESSION );
+    if ( ret != Z_OK ) {
+        ERROR_LOG( "zlib error: " << ret )
+        _stream.reset();
+    }
+}
+
+Compression::StreamZipper::~StreamZipper()
+{
+    if ( _stream ) {
+        deflateEnd( _stream.get() );
+    }
+}
+
+bool Compression::StreamZipper::zip( const uint8_t * src, const size_t srcSize, const bool isLast, std::vector<uint8_t> & output )
+{
+    if ( _isFinished ) {
+        return false;
+    }
+
+    if ( _format == StreamFormat::FAST_LZ ) {
+        _isFinished = isLast;
+
+        if ( srcSize == 0 ) {
+            return true;
+        }
+
+        const uint32_t srcSize32 = static_cast<uint32_t>( srcSize );
+        if ( srcSize32 != srcSize ) {
+            ERROR_LOG( "The size of the source data is too large" )
+            return false;
+        }
+
+        const size_t headerPos = output.size();
+        writeLE32( output, srcSize32 );
+        writeLE32( output, 0 );
+
+        fastZipBlock( src, srcSize, output );
+
+        const uint32_t zipSize32 = static_cast<uint32_t>( output.size() - headerPos - fastLzBlockHeaderSize );
+        for ( size_t i = 0; i < 4; ++i ) {
+            output[headerPos + 4 + i] = static_cast<uint8_t>( ( zipSize32 >> ( 8 * i ) ) & 0xFF );
+        }
+
+        return true;
+    }
+
+    if ( !_stream ) {
+        return false;
+    }
+
+    const uInt srcSizeUInt = static_cast<uInt>( srcSize );
+    if ( srcSizeUInt != srcSize ) {
+        ERROR_LOG( "The size of the source data is too large" )
+        return false;
+    }
+
+    // zlib does not modify the input data, but its API does not declare it as const.
+    _stream->next_in = const_cast<Bytef *>( src );
+    _stream->avail_in = srcSizeUInt;
+
+    const int flush = isLast ? Z_FINISH : Z_NO_FLUSH;
+    constexpr uInt outputPortionSize = 64 * 1024;
+
+    int ret = Z_OK;
+    do {
+        const size_t outputSize = output.size();
+        output.resize( outputSize + outputPortionSize );
+
+        _stream->next_out = output.data() + outputSize;
+        _stream->avail_out = outputPortionSize;
+
+        ret = deflate( _stream.get(), flush );
+        if ( ret == Z_STREAM_ERROR ) {
+            ERROR_LOG( "zlib error: " << ret )
+            _stream->next_in = nullptr;
+            return false;
+        }
+
+        output.resize( outputSize + outputPortionSize - _stream->avail_out );
+    } while ( isLast ? ( ret != Z_STREAM_END ) : ( _stream->avail_out == 0 ) );
+
+    // The input data is not used after this call.
+    _stream->next_in = nullptr;
+
+    assert( _stream->avail_in == 0 );
+
+    _isFinished = isLast;
+
+    return true;
+}
+
 fheroes2::Image Compression::CreateImageFromZlib( int32_t width, int32_t height, const uint8_t * imageData, size_t imageSize, bool doubleLayer )
 {
     if ( imageData == nullptr || imageSize == 0 || width <= 0 || height <= 0 ) {
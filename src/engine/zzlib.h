@@ -25,6 +25,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 #include "image.h"
@@ -33,6 +34,8 @@ class IStreamBase;
 class OStreamBase;
 class IStreamBuf;
 
+struct z_stream_s;
+
 namespace Compression
 {
     // Unzips the input data and returns the uncompressed data or an empty vector in case of an error.
@@ -59,5 +62,49 @@ namespace Compression
     // true on success and false on error.
     bool zipStreamBuf( const IStreamBuf & inputStream, OStreamBase & outputStream );
 
+    // Formats of the zipped data which can be read by unzipStream().
+    enum class StreamFormat : uint16_t
+    {
+        // A single zlib stream.
+        ZLIB = 0,
+        // A sequence of blocks zipped by the fast LZ codec. It is zipped and unzipped much faster than zlib but takes more space.
+        FAST_LZ = 1
+    };
+
+    // The size of the header written before the zipped data by zipStreamBuf().
+    constexpr size_t zipStreamHeaderSize{ 12 };
+
+    // Writes the header which must precede the zipped data in order to read this data by unzipStream().
+    void writeZipStreamHeader( OStreamBase & outputStream, const uint32_t rawSize, const uint32_t zipSize, const StreamFormat format = StreamFormat::ZLIB );
+
+    // Zips the data passed by multiple portions. In case of the zlib format the result is a single zlib stream, the same as zipping all
+    // the data at once. In case of the fast LZ format every portion is zipped as a separate block.
+    class StreamZipper
+    {
+    public:
+        explicit StreamZipper( const StreamFormat format = StreamFormat::ZLIB );
+        StreamZipper( const StreamZipper & ) = delete;
+
+        ~StreamZipper();
+
+        StreamZipper & operator=( const StreamZipper & ) = delete;
+
+        // Zips the next portion of the data and appends the zipped data to the end of the output buffer. The zlib stream is finished
+        // if 'isLast' is set and no more data can be zipped after that. Returns true on success and false on error.
+        bool zip( const uint8_t * src, const size_t srcSize, const bool isLast, std::vector<uint8_t> & output );
+
+        StreamFormat format() const
+        {
+            return _format;
+        }
+
+    private:
+        const StreamFormat _format;
+
+        std::unique_ptr<z_stream_s> _stream;
+
+        bool _isFinished{ false };
+    };
+
     fheroes2::Image CreateImageFromZlib( int32_t width, int32_t height, const uint8_t * imageData, size_t imageSize, bool doubleLayer );
 }
@@ -38,16 +38,25 @@ namespace
 }
 
 std::vector<uint8_t> AGG::getDataFromAggFile( const std::string & key, const bool ignoreExpansion )
+{
+    const fheroes2::FileData fileData = getFileDataFromAggFile( key, ignoreExpansion );
+    if ( fileData.size() == 0 ) {
+        return {};
+    }
+
+    return { fileData.data(), fileData.data() + fileData.size() };
+}
+
+fheroes2::FileData AGG::getFileDataFromAggFile( const std::string & key, const bool ignoreExpansion )
 {
     if ( !ignoreExpansion && heroes2x_agg.isGood() ) {
-        // Make sure that the below container is not const and not a reference
-        // so returning it from the function will invoke a move constructor instead of copy constructor.
-        std::vector<uint8_t> buf = heroes2x_agg.read( key );
-        if ( !buf.empty() )
-            return buf;
+        fheroes2::FileData fileData = heroes2x_agg.getData( key );
+        if ( fileData.size() > 0 ) {
+            return fileData;
+        }
     }
 
-    return heroes2_agg.read( key );
+    return heroes2_agg.getData( key );
 }
 
 AGG::AGGInitializer::AGGInitializer()
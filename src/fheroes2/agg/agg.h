@@ -27,6 +27,8 @@
 #include <string>
 #include <vector>
 
+#include "memory_mapped_file.h"
+
 namespace AGG
 {
     class AGGInitializer final
@@ -57,6 +59,11 @@ namespace AGG
 
     std::vector<uint8_t> getDataFromAggFile( const std::string & key, const bool ignoreExpansion );
 
+    // Returns the data of the AGG file or empty data if the data does not exist. The data is not copied if the AGG file is memory-mapped,
+    // otherwise it is read from the disk. The data stays valid until AGG files are closed. This function can be called from multiple threads
+    // at the same time.
+    fheroes2::FileData getFileDataFromAggFile( const std::string & key, const bool ignoreExpansion );
+
     // Only for internal usage within AGG namespace.
     bool isPoLResourceFilePresent();
 }
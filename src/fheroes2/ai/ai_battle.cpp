@@ -652,7 +652,8 @@ namespace
 
 AI::BattlePlanner & AI::BattlePlanner::Get()
 {
-    static BattlePlanner ai;
+    // The state of the battle planner is tied to the battle being held in the calling thread.
+    thread_local BattlePlanner ai;
     return ai;
 }
 
@@ -74,6 +74,7 @@
 #include "settings.h"
 #include "skill.h"
 #include "spell.h"
+#include "thread.h"
 #include "visit.h"
 #include "world.h"
 #include "world_pathfinding.h"
@@ -905,6 +906,18 @@ namespace
             return iter->second;
         }
 
+        // Evaluates the value of an object without caching it. Unlike other methods, this method can be called concurrently.
+        double evaluate( const IndexObject & objectInfo, const uint32_t distance ) const
+        {
+            return _ai.getObjectValue( _hero, objectInfo.first, objectInfo.second, _ignoreValue, distance );
+        }
+
+        // Stores the value of an object evaluated by the evaluate() method unless some value has already been cached for this object.
+        void store( const IndexObject & objectInfo, const double value )
+        {
+            _objectValue.try_emplace( objectInfo, value );
+        }
+
         double futureValue( const IndexObject & objectInfo, const uint32_t distance )
         {
             const auto [iter, inserted] = _futureObjectValue.try_emplace( objectInfo, 0.0 );
@@ -923,6 +936,22 @@ namespace
         std::map<IndexObject, double> _futureObjectValue;
     };
 
+    // An object that has been found suitable to visit by a hero.
+    struct ObjectCandidate
+    {
+        IndexObject object;
+        uint32_t distance{ 0 };
+        bool useDimensionDoor{ false };
+        bool isCurrentlyValid{ false };
+        double value{ 0 };
+    };
+
+    MultiThreading::ThreadPool & getObjectEvaluationThreadPool()
+    {
+        static MultiThreading::ThreadPool pool;
+        return pool;
+    }
+
     double getMonsterUpgradeValue( const Army & army, const int monsterId )
     {
         const uint32_t monsterCount = army.GetCountMonsters( monsterId );
@@ -2587,6 +2616,9 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
         }
     }
 
+    std::vector<ObjectCandidate> candidates;
+    candidates.reserve( _mapActionObjects.size() );
+
     for ( const auto & [idx, objType] : _mapActionObjects ) {
         const bool isCurrentlyValid = objectValidator.isCurrentlyValid( idx );
         const int32_t daysToBeAvailable = isFutureObjectPredictionAllowed ? objectValidator.whenGoingToBeValidInDays( idx ) : 0;
@@ -2618,16 +2650,42 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
             }
         }
 
-        double value = 0;
-        if ( isCurrentlyValid ) {
-            value = valueStorage.value( { idx, objType }, dist );
+        candidates.push_back( { { idx, objType }, dist, useDimensionDoor, isCurrentlyValid, 0.0 } );
+    }
+
+    // The order of objects in _mapActionObjects is not defined, so they are sorted by their indexes to make sure that the
+    // object with the lowest index is chosen among the objects with the same value.
+    std::sort( candidates.begin(), candidates.end(),
+               []( const ObjectCandidate & first, const ObjectCandidate & second ) { return first.object.first < second.object.first; } );
+
+    // Evaluation of currently valid objects doesn't change the state of anything, so it can be done in parallel.
+    getObjectEvaluationThreadPool().run( candidates.size(), [&candidates, &valueStorage]( const size_t i ) {
+        ObjectCandidate & candidate = candidates[i];
+
+        if ( candidate.isCurrentlyValid ) {
+            candidate.value = valueStorage.evaluate( candidate.object, candidate.distance );
         }
-        else {
+    } );
+
+    for ( ObjectCandidate & candidate : candidates ) {
+        if ( candidate.isCurrentlyValid ) {
+            valueStorage.store( candidate.object, candidate.value );
+        }
+    }
+
+    for ( ObjectCandidate & candidate : candidates ) {
+        const auto & [idx, objType] = candidate.object;
+
+        uint32_t dist = candidate.distance;
+        double value = candidate.value;
+
+        if ( !candidate.isCurrentlyValid ) {
+            // Evaluation of future objects temporarily modifies the map, so it cannot be done in parallel.
             assert( isFutureObjectPredictionAllowed );
-            value = valueStorage.futureValue( { idx, objType }, dist );
+            value = valueStorage.futureValue( candidate.object, dist );
         }
 
-        getObjectValue( idx, dist, value, objType, useDimensionDoor );
+        getObjectValue( idx, dist, value, objType, candidate.useDimensionDoor );
 
         if ( dist > 0 && value > maxPriority ) {
             priorityTarget = idx;
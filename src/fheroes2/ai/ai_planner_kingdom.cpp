@@ -442,6 +442,9 @@ std::set<int> AI::Planner::findCastlesInDanger( const Kingdom & kingdom )
     _pathfinder.setMinimalArmyStrengthAdvantage( ARMY_ADVANTAGE_DESPERATE );
     _pathfinder.setSpellPointsReserveRatio( 0.0 );
 
+    // Enemy armies should be iterated in the outer loop: the distances from the same enemy army to all castles of this kingdom are
+    // taken from the same pathfinder cache, so there will be at most one (distance-limited) map search per enemy army instead of
+    // one search per each pair of an enemy army and a castle.
     for ( const auto & [dummy, enemyArmy] : _enemyArmies ) {
         for ( const Castle * castle : kingdom.GetCastles() ) {
             if ( castle == nullptr ) {
@@ -517,7 +520,9 @@ bool AI::Planner::updateIndividualPriorityForCastle( const Castle & castle, cons
     //
     // Of course, on the other hand, it may be the other way around - the enemy army may have access to some path that is not yet visible to the castle owner,
     // but since the castle owner doesn't know about this for sure, using this option smacks of cheating.
-    const uint32_t dist = _pathfinder.getDistance( enemyArmy.index, castleIndex, castle.GetColor(), enemyArmy.strength );
+    //
+    // There is no need to explore the map beyond the threat distance limit.
+    const uint32_t dist = _pathfinder.getDistance( enemyArmy.index, castleIndex, castle.GetColor(), enemyArmy.strength, Skill::Level::EXPERT, threatDistanceLimit );
     if ( dist == 0 || dist >= threatDistanceLimit ) {
         return false;
     }
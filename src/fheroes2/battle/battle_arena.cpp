@@ -70,7 +70,9 @@
 
 namespace
 {
-    Battle::Arena * arena = nullptr;
+    // Every thread may hold its own battle (for example, when several AI-vs-AI battles are resolved
+    // concurrently) so the currently active arena is tracked per thread.
+    thread_local Battle::Arena * arena = nullptr;
 
     template <typename T>
     Battle::Unit * getLastResurrectableUnitFromGraveyardTmpl( const Battle::Graveyard & graveyard, const HeroBase * commander, const int32_t index, const T & spells )
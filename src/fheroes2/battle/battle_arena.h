@@ -243,6 +243,8 @@ namespace Battle
 
         int32_t GetFreePositionNearHero( const PlayerColor heroColor ) const;
 
+        // The following static accessors refer to the arena of the battle which is being
+        // held in the calling thread. Each thread can have at most one active battle.
         static Board * GetBoard();
         static Tower * GetTower( const TowerType type );
         static Bridge * GetBridge();
@@ -378,5 +380,6 @@ namespace Battle
         };
     };
 
+    // Returns the arena of the battle which is being held in the calling thread or nullptr if there is no such battle.
     Arena * GetArena();
 }
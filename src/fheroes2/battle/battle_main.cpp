@@ -25,6 +25,7 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <initializer_list>
 #include <ostream>
 #include <set>
 #include <string>
@@ -42,6 +43,7 @@
 #include "captain.h"
 #include "dialog.h"
 #include "game.h"
+#include "game_assets.h"
 #include "heroes.h"
 #include "heroes_base.h"
 #include "kingdom.h"
@@ -382,6 +384,21 @@ Battle::Result Battle::Loader( Army & attackingArmy, Army & defendingArmy, const
     }
 #endif
 
+    if ( showBattle ) {
+        // Start decoding of the troop images while the battlefield is being prepared.
+        std::vector<int> monsterIcnIds;
+        for ( const Army * army : { &attackingArmy, &defendingArmy } ) {
+            for ( size_t i = 0; i < army->Size(); ++i ) {
+                const Troop * troop = army->GetTroop( i );
+                if ( troop != nullptr && troop->isValid() ) {
+                    monsterIcnIds.push_back( troop->GetMonsterSprite() );
+                }
+            }
+        }
+
+        Assets::prefetchImages( monsterIcnIds );
+    }
+
     const uint32_t battleSeed = computeBattleSeed( tileIndex, world.GetMapSeed(), attackingArmy, defendingArmy );
 
     while ( true ) {
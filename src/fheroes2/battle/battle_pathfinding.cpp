@@ -25,7 +25,6 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
-#include <set>
 #include <tuple>
 #include <vector>
 
@@ -42,6 +41,52 @@ namespace
 
 namespace Battle
 {
+    size_t BattlePathfinder::_getNodeSlot( const BattleNodeIndex & index )
+    {
+        const auto [headCellIdx, tailCellIdx] = index;
+        assert( Board::isValidIndex( headCellIdx ) );
+
+        const size_t slot = static_cast<size_t>( headCellIdx ) * _nodesPerCell;
+
+        if ( tailCellIdx == -1 ) {
+            return slot;
+        }
+
+        if ( tailCellIdx == headCellIdx - 1 ) {
+            return slot + 1;
+        }
+
+        assert( tailCellIdx == headCellIdx + 1 );
+
+        return slot + 2;
+    }
+
+    const BattleNode * BattlePathfinder::_findNode( const BattleNodeIndex & index ) const
+    {
+        const size_t slot = _getNodeSlot( index );
+
+        if ( _nodeGenerations[slot] != _generation ) {
+            return nullptr;
+        }
+
+        return &_nodes[slot];
+    }
+
+    BattleNode & BattlePathfinder::_getNode( const BattleNodeIndex & index )
+    {
+        const size_t slot = _getNodeSlot( index );
+
+        BattleNode & node = _nodes[slot];
+
+        if ( _nodeGenerations[slot] != _generation ) {
+            _nodeGenerations[slot] = _generation;
+
+            node = {};
+        }
+
+        return node;
+    }
+
     void BattlePathfinder::reEvaluateIfNeeded( const Unit & unit )
     {
         assert( unit.GetHeadIndex() != -1 && ( unit.isWide() ? unit.GetTailIndex() != -1 : unit.GetTailIndex() == -1 ) );
@@ -73,8 +118,15 @@ namespace Battle
         const Castle * castle = Arena::GetCastle();
         const bool isMoatBuilt = castle && castle->isBuild( BUILD_MOAT );
 
-        _cache.clear();
-        _cache.try_emplace( _pathStart );
+        // Clear the graph. Generation 0 is never used, so all the nodes are considered outdated on the first run.
+        ++_generation;
+
+        if ( _generation == 0 ) {
+            _nodeGenerations.fill( 0 );
+            _generation = 1;
+        }
+
+        _getNode( _pathStart );
 
         // Flying units can land wherever they can fit
         if ( _isFlying ) {
@@ -90,12 +142,13 @@ namespace Battle
                 const int32_t headCellIdx = pos.GetHead()->GetIndex();
                 const int32_t tailCellIdx = pos.GetTail() ? pos.GetTail()->GetIndex() : -1;
 
-                if ( const auto [iter, inserted] = _cache.try_emplace( { headCellIdx, tailCellIdx } ); inserted ) {
+                const BattleNodeIndex nodeIdx{ headCellIdx, tailCellIdx };
+                if ( _findNode( nodeIdx ) == nullptr ) {
                     // Wide units can occupy overlapping positions, the distance between which is actually zero,
                     // but since the movement takes place, we will consider the distance equal to 1 in this case
                     const uint32_t distance = std::max<uint32_t>( Board::GetDistance( unit.GetPosition(), pos ), 1U );
 
-                    iter->second.update( _pathStart, 1, distance );
+                    _getNode( nodeIdx ).update( _pathStart, 1, distance );
                 }
             }
 
@@ -132,7 +185,7 @@ namespace Battle
 
         for ( size_t nodesToExploreIdx = 0; nodesToExploreIdx < nodesToExplore.size(); ++nodesToExploreIdx ) {
             const BattleNodeIndex currentNodeIdx = nodesToExplore[nodesToExploreIdx];
-            const BattleNode & currentNode = _cache[currentNodeIdx];
+            const BattleNode & currentNode = _getNode( currentNodeIdx );
 
             if ( _isWide ) {
                 assert( currentNodeIdx.first != -1 && currentNodeIdx.second != -1 );
@@ -169,7 +222,7 @@ namespace Battle
                     const uint32_t cost = currentNode._cost + ( newNodeIdx == flippedCurrentNodeIdx ? 0 : movementPenalty );
                     const uint32_t distance = currentNode._distance + ( newNodeIdx == flippedCurrentNodeIdx ? 0 : 1 );
 
-                    BattleNode & newNode = _cache[newNodeIdx];
+                    BattleNode & newNode = _getNode( newNodeIdx );
                     if ( newNode._from == BattleNodeIndex{ -1, -1 } || newNode._cost > cost ) {
                         newNode.update( currentNodeIdx, cost, distance );
 
@@ -206,7 +259,7 @@ namespace Battle
                     const uint32_t cost = currentNode._cost + movementPenalty;
                     const uint32_t distance = currentNode._distance + 1;
 
-                    BattleNode & newNode = _cache[newNodeIdx];
+                    BattleNode & newNode = _getNode( newNodeIdx );
                     if ( newNode._from == BattleNodeIndex{ -1, -1 } || newNode._cost > cost ) {
                         newNode.update( currentNodeIdx, cost, distance );
 
@@ -228,14 +281,12 @@ namespace Battle
 
         const BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        const auto iter = _cache.find( nodeIdx );
-        if ( iter == _cache.end() ) {
+        const BattleNode * node = _findNode( nodeIdx );
+        if ( node == nullptr ) {
             return false;
         }
 
-        const auto & [index, node] = *iter;
-
-        return ( index == _pathStart || node._from != BattleNodeIndex{ -1, -1 } ) && ( !isOnCurrentTurn || node._cost <= _speed );
+        return ( nodeIdx == _pathStart || node->_from != BattleNodeIndex{ -1, -1 } ) && ( !isOnCurrentTurn || node->_cost <= _speed );
     }
 
     uint32_t BattlePathfinder::getCost( const Unit & unit, const Position & position )
@@ -246,14 +297,13 @@ namespace Battle
 
         const BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        const auto iter = _cache.find( nodeIdx );
-        assert( iter != _cache.end() );
+        const BattleNode * node = _findNode( nodeIdx );
+        assert( node != nullptr );
 
-        const auto & [index, node] = *iter;
         // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-        assert( ( index == _pathStart || node._from != BattleNodeIndex{ -1, -1 } ) );
+        assert( ( nodeIdx == _pathStart || node->_from != BattleNodeIndex{ -1, -1 } ) );
 
-        return node._cost;
+        return node->_cost;
     }
 
     uint32_t BattlePathfinder::getDistance( const Unit & unit, const Position & position )
@@ -264,36 +314,41 @@ namespace Battle
 
         const BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        const auto iter = _cache.find( nodeIdx );
-        assert( iter != _cache.end() );
+        const BattleNode * node = _findNode( nodeIdx );
+        assert( node != nullptr );
 
-        const auto & [index, node] = *iter;
         // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-        assert( ( index == _pathStart || node._from != BattleNodeIndex{ -1, -1 } ) );
+        assert( ( nodeIdx == _pathStart || node->_from != BattleNodeIndex{ -1, -1 } ) );
 
-        return node._distance;
+        return node->_distance;
     }
 
     Indexes BattlePathfinder::getAllAvailableMoves( const Unit & unit )
     {
         reEvaluateIfNeeded( unit );
 
-        std::set<int32_t> boardIndexes;
-
-        for ( const auto & [index, node] : _cache ) {
-            if ( index == _pathStart || node._from == BattleNodeIndex{ -1, -1 } || node._cost > _speed ) {
-                continue;
-            }
+        Indexes result;
+        result.reserve( Board::sizeInCells );
 
-            assert( index.first != -1 );
+        // Nodes are stored in the order of the indexes of their head cells, so the result is sorted and every index is added only once
+        for ( int32_t headCellIdx = 0; headCellIdx < Board::sizeInCells; ++headCellIdx ) {
+            const size_t firstSlot = static_cast<size_t>( headCellIdx ) * _nodesPerCell;
 
-            boardIndexes.insert( index.first );
-        }
+            for ( size_t slot = firstSlot; slot < firstSlot + _nodesPerCell; ++slot ) {
+                if ( _nodeGenerations[slot] != _generation ) {
+                    continue;
+                }
 
-        Indexes result;
+                const BattleNode & node = _nodes[slot];
+                if ( node._from == BattleNodeIndex{ -1, -1 } || node._cost > _speed ) {
+                    // The path start node is the only one without the previous node
+                    continue;
+                }
 
-        result.reserve( boardIndexes.size() );
-        result.assign( boardIndexes.begin(), boardIndexes.end() );
+                result.push_back( headCellIdx );
+                break;
+            }
+        }
 
         return result;
     }
@@ -310,21 +365,21 @@ namespace Battle
         BattleNodeIndex lastReachableNodeIdx{ -1, -1 };
         BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        for ( auto iter = _cache.find( nodeIdx ); iter != _cache.end(); iter = _cache.find( nodeIdx ) ) {
-            const auto & [index, node] = *iter;
+        for ( const BattleNode * node = _findNode( nodeIdx ); node != nullptr; node = _findNode( nodeIdx ) ) {
+            const BattleNodeIndex index = nodeIdx;
 
             if ( index == _pathStart ) {
                 break;
             }
 
             // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-            assert( ( node._from != BattleNodeIndex{ -1, -1 } ) );
+            assert( ( node->_from != BattleNodeIndex{ -1, -1 } ) );
 
-            nodeIdx = node._from;
+            nodeIdx = node->_from;
 
             // A given position may be reachable in principle, but is not reachable on the current turn.
             // Skip the steps that are not reachable on this turn.
-            if ( node._cost > _speed ) {
+            if ( node->_cost > _speed ) {
                 continue;
             }
 
@@ -365,21 +420,21 @@ namespace Battle
 
         BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        for ( auto iter = _cache.find( nodeIdx ); iter != _cache.end(); iter = _cache.find( nodeIdx ) ) {
-            const auto & [index, node] = *iter;
+        for ( const BattleNode * node = _findNode( nodeIdx ); node != nullptr; node = _findNode( nodeIdx ) ) {
+            const BattleNodeIndex index = nodeIdx;
 
             if ( index == _pathStart ) {
                 break;
             }
 
             // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-            assert( ( node._from != BattleNodeIndex{ -1, -1 } ) );
+            assert( ( node->_from != BattleNodeIndex{ -1, -1 } ) );
 
-            nodeIdx = node._from;
+            nodeIdx = node->_from;
 
             // A given position may be reachable in principle, but is not reachable on the current turn.
             // Skip the steps that are not reachable on this turn.
-            if ( node._cost > _speed ) {
+            if ( node->_cost > _speed ) {
                 continue;
             }
 
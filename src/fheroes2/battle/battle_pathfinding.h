@@ -23,7 +23,6 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
-#include <unordered_map>
 #include <utility>
 
 #include "battle_board.h"
@@ -36,19 +35,6 @@ namespace Battle
 
     using BattleNodeIndex = std::pair<int32_t, int32_t>;
 
-    struct BattleNodeIndexHash final
-    {
-        std::size_t operator()( const BattleNodeIndex & index ) const noexcept
-        {
-            const uint64_t f = index.first;
-            const uint64_t s = index.second;
-
-            std::hash<uint64_t> hasher;
-
-            return hasher( ( f << 32 ) + s );
-        }
-    };
-
     struct BattleNode final
     {
         BattleNodeIndex _from{ -1, -1 };
@@ -109,7 +95,24 @@ namespace Battle
         // Rebuilds the graph of available positions for the given unit if necessary (if it is not already cached)
         void reEvaluateIfNeeded( const Unit & unit );
 
-        std::unordered_map<BattleNodeIndex, BattleNode, BattleNodeIndexHash> _cache;
+        // Returns the node with the given index if it belongs to the current graph, otherwise returns nullptr
+        const BattleNode * _findNode( const BattleNodeIndex & index ) const;
+
+        // Returns the node with the given index, adding it to the current graph if necessary
+        BattleNode & _getNode( const BattleNodeIndex & index );
+
+        // Every node is identified by the index of the head cell and the location of the tail cell relative to
+        // the head cell: there is no tail, the tail is to the left of the head or the tail is to the right of it
+        static const size_t _nodesPerCell{ 3 };
+        static const size_t _nodesCount{ Board::sizeInCells * _nodesPerCell };
+
+        static size_t _getNodeSlot( const BattleNodeIndex & index );
+
+        // The graph is stored in a fixed-size array. The node belongs to the current graph only if its generation
+        // is equal to the current generation, so the whole graph is cleared just by incrementing the generation.
+        std::array<BattleNode, _nodesCount> _nodes;
+        std::array<uint32_t, _nodesCount> _nodeGenerations{};
+        uint32_t _generation{ 0 };
 
         // Parameters of the unit for which the current cache is created
         BattleNodeIndex _pathStart{ -1, -1 };
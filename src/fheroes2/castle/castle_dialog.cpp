@@ -57,6 +57,7 @@
 #include "monster.h"
 #include "mus.h"
 #include "screen.h"
+#include "settings.h"
 #include "statusbar.h"
 #include "tools.h"
 #include "translations.h"
@@ -224,6 +225,16 @@ Castle::CastleDialogReturnValue Castle::OpenDialog( const bool openConstructionW
     // or from the Game Area that will set the appropriate cursor after this dialog is closed.
     Cursor::Get().SetThemes( Cursor::POINTER );
 
+    // Start decoding of the images of all built buildings while the dialog is being prepared.
+    std::vector<int> buildingIcnIds;
+    for ( const BuildingType building : fheroes2::getBuildingDrawingPriorities( _race, Settings::Get().getCurrentMapInfo().version ) ) {
+        if ( isBuild( building ) ) {
+            buildingIcnIds.push_back( GetICNBuilding( building, _race ) );
+        }
+    }
+
+    Assets::prefetchImages( buildingIcnIds );
+
     fheroes2::Display & display = fheroes2::Display::instance();
 
     fheroes2::Rect dialogRoi;
@@ -46,6 +46,7 @@
 #include "localevent.h"
 #include "logging.h"
 #include "maps_fileinfo.h"
+#include "maps_fileinfo_cache.h"
 #include "math_base.h"
 #include "screen.h"
 #include "settings.h"
@@ -231,16 +232,9 @@ namespace
         ListFiles files;
         files.ReadDir( Game::GetSaveDir(), Game::GetSaveFileExtension() );
 
-        MapsFileInfoList mapInfos;
-        mapInfos.reserve( files.size() );
-
-        for ( std::string & saveFile : files ) {
-            Maps::FileInfo mapInfo;
-
-            if ( Game::LoadSAV2FileInfo( std::move( saveFile ), mapInfo ) ) {
-                mapInfos.emplace_back( std::move( mapInfo ) );
-            }
-        }
+        // The result of reading a save file depends on the current game type. Save files are not read in parallel since reading them
+        // changes the global version of the current save file.
+        MapsFileInfoList mapInfos = Maps::getCachedFileInfos( files, "sav_" + std::to_string( Settings::Get().GameType() ), &Game::LoadSAV2FileInfo, false );
 
         sortMapInfos( mapInfos );
 
@@ -1538,6 +1538,7 @@ namespace Interface
         reset();
 
         _historyManager.reset();
+        _historyManager.setMemoryLimit( conf.editorHistoryMemoryLimit() );
 
         // Stop all sounds and music.
         AudioManager::ResetAudio();
@@ -20,13 +20,22 @@
 
 #include "history_manager.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <map>
+#include <set>
+#include <utility>
+#include <vector>
 
 #include "map_format_helper.h"
 #include "map_format_info.h"
+#include "map_object_info.h"
+#include "maps_tiles.h"
+#include "maps_tiles_helper.h"
 #include "serialize.h"
+#include "world.h"
 #include "world_object_uid.h"
 
 namespace
@@ -45,81 +54,316 @@ namespace
         virtual bool prepare() = 0;
     };
 
-    // This class holds 2 copies of MapFormat objects in a compressed format:
-    // - one copy before the action
-    // - one copy after the action
+    bool isTileObjectEqual( const Maps::Map_Format::TileObjectInfo & first, const Maps::Map_Format::TileObjectInfo & second )
+    {
+        return first.id == second.id && first.group == second.group && first.index == second.index;
+    }
+
+    bool isTileEqual( const Maps::Map_Format::TileInfo & first, const Maps::Map_Format::TileInfo & second )
+    {
+        return first.terrainIndex == second.terrainIndex && first.terrainFlags == second.terrainFlags
+               && std::equal( first.objects.begin(), first.objects.end(), second.objects.begin(), second.objects.end(), isTileObjectEqual );
+    }
+
+    size_t getTileMemoryUsage( const Maps::Map_Format::TileInfo & tile )
+    {
+        return sizeof( Maps::Map_Format::TileInfo ) + tile.objects.size() * sizeof( Maps::Map_Format::TileObjectInfo );
+    }
+
+    // Returns true if the object is linked to players' data (towns, heroes, capturable objects) which is updated only when the whole map is read.
+    bool isPlayerRelatedObject( const Maps::Map_Format::TileObjectInfo & object )
+    {
+        switch ( object.group ) {
+        case Maps::ObjectGroup::KINGDOM_TOWNS:
+        case Maps::ObjectGroup::KINGDOM_HEROES:
+        case Maps::ObjectGroup::LANDSCAPE_TOWN_BASEMENTS:
+        case Maps::ObjectGroup::LANDSCAPE_FLAGS:
+            return true;
+        case Maps::ObjectGroup::ADVENTURE_MISCELLANEOUS:
+        case Maps::ObjectGroup::ADVENTURE_MINES: {
+            const auto & objects = Maps::getObjectsByGroup( object.group );
+            assert( object.index < objects.size() );
+
+            return object.index < objects.size() && Maps::isCapturableObject( objects[object.index].objectType );
+        }
+        default:
+            break;
+        }
+
+        return false;
+    }
+
+    // Returns the map serialized in a compressed form.
+    std::vector<uint8_t> compressMap( const Maps::Map_Format::MapFormat & mapFormat )
+    {
+        RWStreamBuf stream;
+        if ( !Maps::Map_Format::saveMap( stream, mapFormat ) ) {
+            assert( 0 );
+            return {};
+        }
+
+        return { stream.data(), stream.data() + stream.size() };
+    }
+
+    bool decompressMap( const std::vector<uint8_t> & data, Maps::Map_Format::MapFormat & mapFormat )
+    {
+        ROStreamBuf stream( data );
+        return Maps::Map_Format::loadMap( stream, mapFormat );
+    }
+
+    // Returns true if all map data except tiles is the same. Both maps must have no tiles.
+    bool isMapDataEqual( const Maps::Map_Format::MapFormat & first, const Maps::Map_Format::MapFormat & second )
+    {
+        assert( first.tiles.empty() && second.tiles.empty() );
+
+        // It is much easier to compare the serialized data than to compare all the map data field by field.
+        RWStreamBuf firstData;
+        RWStreamBuf secondData;
+
+        if ( !Maps::Map_Format::saveMap( firstData, first ) || !Maps::Map_Format::saveMap( secondData, second ) ) {
+            assert( 0 );
+            return false;
+        }
+
+        return firstData.size() == secondData.size() && std::equal( firstData.data(), firstData.data() + firstData.size(), secondData.data() );
+    }
+
+    // Returns the map without its tiles.
+    Maps::Map_Format::MapFormat getMapWithoutTiles( Maps::Map_Format::MapFormat & mapFormat )
+    {
+        std::vector<Maps::Map_Format::TileInfo> tiles = std::move( mapFormat.tiles );
+
+        Maps::Map_Format::MapFormat result = mapFormat;
+
+        mapFormat.tiles = std::move( tiles );
+
+        return result;
+    }
+
+    // This class holds only the tiles that were changed by the action, in their states before and after the action.
+    // If the map was resized or any data except tiles was changed it holds compressed copies of the whole map before and after the action.
+    // Until the action is prepared it holds a compressed copy of the map before the action.
     class GenericMapAction final : public BaseMapAction
     {
     public:
         explicit GenericMapAction( Maps::Map_Format::MapFormat & mapFormat )
             : _mapFormat( mapFormat )
+            , _beforeMapData( compressMap( mapFormat ) )
             , _latestObjectUIDBefore( Maps::getLastObjectUID() )
         {
-            if ( !Maps::Map_Format::saveMap( _beforeMapFormat, _mapFormat ) ) {
-                assert( 0 );
-            }
+            // Do nothing.
         }
 
         bool prepare() override
         {
-            if ( !Maps::Map_Format::saveMap( _afterMapFormat, _mapFormat ) ) {
+            assert( !_isPrepared );
+
+            _isPrepared = true;
+            _latestObjectUIDAfter = Maps::getLastObjectUID();
+
+            Maps::Map_Format::MapFormat beforeMapFormat;
+            if ( !decompressMap( _beforeMapData, beforeMapFormat ) ) {
                 assert( 0 );
                 return false;
             }
 
-            _latestObjectUIDAfter = Maps::getLastObjectUID();
+            if ( beforeMapFormat.tiles.size() == _mapFormat.tiles.size() ) {
+                std::vector<Maps::Map_Format::TileInfo> beforeTiles = std::move( beforeMapFormat.tiles );
+                beforeMapFormat.tiles = {};
+
+                if ( isMapDataEqual( beforeMapFormat, getMapWithoutTiles( _mapFormat ) ) ) {
+                    for ( size_t i = 0; i < _mapFormat.tiles.size(); ++i ) {
+                        const Maps::Map_Format::TileInfo & afterTile = _mapFormat.tiles[i];
+
+                        if ( isTileEqual( beforeTiles[i], afterTile ) ) {
+                            continue;
+                        }
+
+                        _memoryUsage += sizeof( TileChange ) + getTileMemoryUsage( beforeTiles[i] ) + getTileMemoryUsage( afterTile );
+                        _tileChanges.push_back( { static_cast<int32_t>( i ), std::move( beforeTiles[i] ), afterTile } );
+                    }
+
+                    _beforeMapData = {};
+
+                    return true;
+                }
+            }
+
+            // The map has been resized or its properties have been changed. Such actions are rare so the whole map is stored.
+            _afterMapData = compressMap( _mapFormat );
+            _isFullCopy = true;
+
+            _memoryUsage = _beforeMapData.size() + _afterMapData.size();
 
             return true;
         }
 
         bool redo() override
         {
-            if ( !Maps::Map_Format::loadMap( _afterMapFormat, _mapFormat ) ) {
-                assert( 0 );
-                return false;
+            assert( _isPrepared );
+
+            if ( _isFullCopy ) {
+                return _readMap( _afterMapData, _latestObjectUIDAfter );
             }
 
-            _afterMapFormat.seek( 0 );
+            return _applyTileChanges( false, _latestObjectUIDAfter );
+        }
 
-            if ( !Maps::readMapInEditor( _mapFormat ) ) {
-                // If this assertion blows up then something is really wrong with the Editor.
-                assert( 0 );
-                return false;
+        bool undo() override
+        {
+            if ( !_isPrepared || _isFullCopy ) {
+                return _readMap( _beforeMapData, _latestObjectUIDBefore );
             }
 
-            Maps::setLastObjectUID( _latestObjectUIDAfter );
+            return _applyTileChanges( true, _latestObjectUIDBefore );
+        }
 
-            return true;
+        size_t memoryUsage() const override
+        {
+            return sizeof( GenericMapAction ) + _memoryUsage;
         }
 
-        bool undo() override
+    private:
+        struct TileChange
         {
-            if ( !Maps::Map_Format::loadMap( _beforeMapFormat, _mapFormat ) ) {
-                assert( 0 );
-                return false;
-            }
+            int32_t tileIndex{ -1 };
+            Maps::Map_Format::TileInfo before;
+            Maps::Map_Format::TileInfo after;
+        };
 
-            _beforeMapFormat.seek( 0 );
+        Maps::Map_Format::MapFormat & _mapFormat;
+
+        std::vector<uint8_t> _beforeMapData;
+        std::vector<uint8_t> _afterMapData;
+
+        std::vector<TileChange> _tileChanges;
+
+        const uint32_t _latestObjectUIDBefore{ 0 };
+        uint32_t _latestObjectUIDAfter{ 0 };
+
+        size_t _memoryUsage{ 0 };
 
-            if ( !Maps::readMapInEditor( _mapFormat ) ) {
+        bool _isPrepared{ false };
+        bool _isFullCopy{ false };
+
+        bool _readMap( const std::vector<uint8_t> & mapData, const uint32_t latestObjectUID )
+        {
+            if ( !decompressMap( mapData, _mapFormat ) || !Maps::readMapInEditor( _mapFormat ) ) {
                 // If this assertion blows up then something is really wrong with the Editor.
                 assert( 0 );
                 return false;
             }
 
-            Maps::setLastObjectUID( _latestObjectUIDBefore );
+            Maps::setLastObjectUID( latestObjectUID );
 
             return true;
         }
 
-    private:
-        Maps::Map_Format::MapFormat & _mapFormat;
+        bool _applyTileChanges( const bool isUndo, const uint32_t latestObjectUID )
+        {
+            // Every object is stored only on its main tile so all objects affected by the action are located on the changed tiles.
+            std::set<uint32_t> changedObjectUIDs;
+            bool isWholeMapUpdateNeeded = false;
+
+            const auto addChangedObjects = [&changedObjectUIDs, &isWholeMapUpdateNeeded]( const std::vector<Maps::Map_Format::TileObjectInfo> & objects,
+                                                                                        const std::vector<Maps::Map_Format::TileObjectInfo> & otherObjects ) {
+                for ( const auto & object : objects ) {
+                    const auto isSameObject = [&object]( const Maps::Map_Format::TileObjectInfo & otherObject ) { return isTileObjectEqual( object, otherObject ); };
+                    if ( std::any_of( otherObjects.begin(), otherObjects.end(), isSameObject ) ) {
+                        continue;
+                    }
+
+                    changedObjectUIDs.emplace( object.id );
+
+                    if ( isPlayerRelatedObject( object ) ) {
+                        isWholeMapUpdateNeeded = true;
+                    }
+                }
+            };
+
+            for ( const TileChange & change : _tileChanges ) {
+                const Maps::Map_Format::TileInfo & currentTile = isUndo ? change.after : change.before;
+                const Maps::Map_Format::TileInfo & newTile = isUndo ? change.before : change.after;
+
+                addChangedObjects( currentTile.objects, newTile.objects );
+                addChangedObjects( newTile.objects, currentTile.objects );
+            }
 
-        RWStreamBuf _beforeMapFormat;
-        RWStreamBuf _afterMapFormat;
+            if ( isWholeMapUpdateNeeded ) {
+                for ( const TileChange & change : _tileChanges ) {
+                    assert( static_cast<size_t>( change.tileIndex ) < _mapFormat.tiles.size() );
 
-        const uint32_t _latestObjectUIDBefore{ 0 };
-        uint32_t _latestObjectUIDAfter{ 0 };
+                    _mapFormat.tiles[change.tileIndex] = isUndo ? change.before : change.after;
+                }
+
+                if ( !Maps::readMapInEditor( _mapFormat ) ) {
+                    // If this assertion blows up then something is really wrong with the Editor.
+                    assert( 0 );
+                    return false;
+                }
+
+                Maps::setLastObjectUID( latestObjectUID );
+
+                return true;
+            }
+
+            // Remove the changed objects from the world tiles. The parts of an object might be placed on the neighboring tiles as well.
+            for ( const TileChange & change : _tileChanges ) {
+                const Maps::Map_Format::TileInfo & currentTile = isUndo ? change.after : change.before;
+
+                for ( const auto & object : currentTile.objects ) {
+                    if ( changedObjectUIDs.count( object.id ) > 0 ) {
+                        Maps::removeObjectFromMapByUID( change.tileIndex, object.id );
+                    }
+                }
+            }
+
+            std::vector<std::pair<int32_t, const Maps::Map_Format::TileObjectInfo *>> objectsToAdd;
+
+            for ( const TileChange & change : _tileChanges ) {
+                assert( static_cast<size_t>( change.tileIndex ) < _mapFormat.tiles.size() );
+
+                const Maps::Map_Format::TileInfo & newTile = isUndo ? change.before : change.after;
+
+                Maps::Map_Format::TileInfo & mapTile = _mapFormat.tiles[change.tileIndex];
+                mapTile = newTile;
+
+                Maps::Tile & worldTile = world.getTile( change.tileIndex );
+                worldTile.setTerrain( mapTile.terrainIndex, mapTile.terrainFlags );
+
+                if ( mapTile.objects.empty() ) {
+                    // No object has its main part on this tile anymore.
+                    worldTile.metadata() = {};
+                }
+
+                for ( const auto & object : mapTile.objects ) {
+                    if ( changedObjectUIDs.count( object.id ) > 0 ) {
+                        objectsToAdd.emplace_back( change.tileIndex, &object );
+                    }
+                }
+            }
+
+            // Objects must be placed in the order of their UIDs, the same way as it is done while reading the whole map.
+            std::stable_sort( objectsToAdd.begin(), objectsToAdd.end(), []( const auto & left, const auto & right ) { return left.second->id < right.second->id; } );
+
+            for ( const auto & [tileIndex, object] : objectsToAdd ) {
+                if ( !Maps::readTileObject( world.getTile( tileIndex ), *object ) ) {
+                    // If this assertion blows up then something is really wrong with the Editor.
+                    assert( 0 );
+                    return false;
+                }
+            }
+
+            for ( const TileChange & change : _tileChanges ) {
+                world.getTile( change.tileIndex ).updateRoadFlag();
+            }
+
+            world.updatePassabilities();
+
+            Maps::setLastObjectUID( latestObjectUID );
+
+            return true;
+        }
     };
 
     template <typename T>
@@ -151,6 +395,12 @@ namespace
             return true;
         }
 
+        size_t memoryUsage() const override
+        {
+            // Metadata may contain strings and containers so this is only an estimation.
+            return sizeof( MetadataMapAction ) + ( _beforeMetadata.size() + _afterMetadata.size() ) * ( sizeof( uint32_t ) + sizeof( T ) );
+        }
+
     private:
         std::map<uint32_t, T> & _metadata;
 
@@ -47,6 +47,9 @@ namespace fheroes2
         virtual bool redo() = 0;
 
         virtual bool undo() = 0;
+
+        // Returns the approximate amount of memory in bytes occupied by this action.
+        virtual size_t memoryUsage() const = 0;
     };
 
     // Remember the map state and create an action if the map has changed.
@@ -112,6 +115,19 @@ namespace fheroes2
             }
         }
 
+        // Sets the maximum amount of memory in bytes for all stored actions, 0 means no limit. The oldest actions are removed to fit
+        // into this limit, but the latest action is always kept regardless of its size.
+        void setMemoryLimit( const size_t limit )
+        {
+            _memoryLimit = limit;
+
+            _removeOldActions();
+
+            if ( _stateCallback ) {
+                _stateCallback( isUndoAvailable(), isRedoAvailable() );
+            }
+        }
+
         void add( std::unique_ptr<Action> action )
         {
             _actions.resize( _lastActionId );
@@ -120,10 +136,7 @@ namespace fheroes2
 
             ++_lastActionId;
 
-            if ( _actions.size() > maxActions ) {
-                --_lastActionId;
-                _actions.pop_front();
-            }
+            _removeOldActions();
 
             if ( _stateCallback ) {
                 _stateCallback( isUndoAvailable(), isRedoAvailable() );
@@ -180,10 +193,30 @@ namespace fheroes2
         // We shouldn't store too many actions. It is extremely rare when there is a need to revert so many changes.
         static const size_t maxActions{ 999 };
 
+        static const size_t defaultMemoryLimit{ 64 * 1024 * 1024 };
+
         std::deque<std::unique_ptr<Action>> _actions;
 
         size_t _lastActionId{ 0 };
 
+        size_t _memoryLimit{ defaultMemoryLimit };
+
         std::function<void( const bool, const bool )> _stateCallback;
+
+        void _removeOldActions()
+        {
+            size_t memoryUsage = 0;
+            for ( const auto & action : _actions ) {
+                memoryUsage += action->memoryUsage();
+            }
+
+            // Only actions that can be undone are removed, and the latest action is always kept.
+            while ( _lastActionId > 0 && _actions.size() > 1 && ( _actions.size() > maxActions || ( _memoryLimit > 0 && memoryUsage > _memoryLimit ) ) ) {
+                memoryUsage -= _actions.front()->memoryUsage();
+
+                --_lastActionId;
+                _actions.pop_front();
+            }
+        }
     };
 }
@@ -21,10 +21,14 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdlib>
 #include <exception>
 #include <iostream>
 #include <memory>
+#include <string_view>
+#include <thread>
 
 // Managing compiler warnings for SDL headers
 #if defined( __GNUC__ )
@@ -49,10 +53,92 @@
 #include "component_base.h"
 #include "exception.h"
 #include "game.h"
+#include "game_auto_playtest.h"
 #include "game_init.h"
 #include "game_invalid_assets.h"
+#include "game_render_benchmark.h"
 #include "logging.h"
 
+namespace
+{
+    // Parses the command line arguments of the headless auto playtest mode:
+    // --autoplaytest <map file> [--playthroughs <count>] [--days <count>] [--seed <value>] [--jobs <count>]
+    // Returns false if the headless mode is not requested.
+    bool parseAutoPlaytestArguments( const int argc, char ** argv, fheroes2::HeadlessAutoPlaytestOptions & options )
+    {
+        options.executablePath = argv[0];
+
+        for ( int i = 1; i < argc; ++i ) {
+            const std::string_view option{ argv[i] };
+
+            if ( option == "--worker" ) {
+                options.isWorker = true;
+                continue;
+            }
+
+            if ( i + 1 == argc ) {
+                break;
+            }
+
+            if ( option == "--autoplaytest" ) {
+                options.mapFilePath = argv[++i];
+            }
+            else if ( option == "--playthroughs" ) {
+                options.playthroughCount = std::clamp( std::atoi( argv[++i] ), 1, fheroes2::HeadlessAutoPlaytestOptions::playthroughLimit );
+            }
+            else if ( option == "--first-playthrough" ) {
+                options.firstPlaythroughId = std::max( std::atoi( argv[++i] ), 0 );
+            }
+            else if ( option == "--days" ) {
+                options.maxDays = std::clamp( std::atoi( argv[++i] ), 1, fheroes2::AutoPlaytest::dayLimit );
+            }
+            else if ( option == "--seed" ) {
+                options.seed = static_cast<uint32_t>( std::strtoul( argv[++i], nullptr, 10 ) );
+            }
+            else if ( option == "--jobs" ) {
+                // Use all available cores if the number of jobs is not positive.
+                const int jobCount = std::atoi( argv[++i] );
+                options.jobCount = ( jobCount > 0 ) ? jobCount : std::max( static_cast<int>( std::thread::hardware_concurrency() ), 1 );
+            }
+        }
+
+        return !options.mapFilePath.empty();
+    }
+
+    // Parses the command line arguments of the render benchmark mode:
+    // --render-benchmark <map file> [--frames <count>] [--resolution <width>x<height>] [--dump-frames <directory>]
+    // Returns false if the render benchmark is not requested.
+    bool parseRenderBenchmarkArguments( const int argc, char ** argv, fheroes2::RenderBenchmarkOptions & options )
+    {
+        for ( int i = 1; i + 1 < argc; ++i ) {
+            const std::string_view option{ argv[i] };
+
+            if ( option == "--render-benchmark" ) {
+                options.mapFilePath = argv[++i];
+            }
+            else if ( option == "--frames" ) {
+                options.frameCount = std::clamp( std::atoi( argv[++i] ), 1, fheroes2::RenderBenchmarkOptions::frameLimit );
+            }
+            else if ( option == "--resolution" ) {
+                char * heightString = nullptr;
+                const long width = std::strtol( argv[++i], &heightString, 10 );
+                if ( *heightString == 'x' && width > 0 ) {
+                    const long height = std::strtol( heightString + 1, nullptr, 10 );
+                    if ( height > 0 ) {
+                        options.width = static_cast<int32_t>( width );
+                        options.height = static_cast<int32_t>( height );
+                    }
+                }
+            }
+            else if ( option == "--dump-frames" ) {
+                options.frameDumpDirectory = argv[++i];
+            }
+        }
+
+        return !options.mapFilePath.empty();
+    }
+}
+
 int main( int argc, char ** argv )
 {
 // SDL2main.lib converts argv to UTF-8, but this application expects ANSI, use the original argv
@@ -60,8 +146,6 @@ int main( int argc, char ** argv )
     assert( argc == __argc );
 
     argv = __argv;
-#else
-    (void)argc;
 #endif
 
     try {
@@ -71,10 +155,35 @@ int main( int argc, char ** argv )
         Game::initDataDir();
         Game::initConfigDir( argv[0] );
 
+        if ( fheroes2::HeadlessAutoPlaytestOptions options; parseAutoPlaytestArguments( argc, argv, options ) ) {
+            // No window is created and no audio device is opened in the headless mode.
+            auto coreComponent = Game::createHeadlessCoreComponent();
+            auto dataComponent = Game::createDataComponent();
+
+            Game::initPalette();
+            Game::initTranslations();
+            Game::initAnimation();
+
+            return fheroes2::runHeadlessAutoPlaytest( options, std::cout ) ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
+        if ( fheroes2::RenderBenchmarkOptions options; parseRenderBenchmarkArguments( argc, argv, options ) ) {
+            // No window is created and no audio device is opened. Frames are rendered only into memory.
+            auto coreComponent = Game::createHeadlessCoreComponent();
+            auto dataComponent = Game::createDataComponent();
+
+            Game::initPalette();
+            Game::initTranslations();
+            Game::initAnimation();
+
+            return fheroes2::runRenderBenchmark( options, std::cout ) ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
         auto coreComponent = Game::createCoreComponent();
         auto displayComponent = Game::createDisplayComponent();
         auto dataComponent = Game::createDataComponent();
         auto audioComponent = Game::createAudioComponent( dataComponent.get() );
+        auto saveWriterComponent = Game::createSaveWriterComponent();
 
         Game::initPalette();
         Game::initTranslations();
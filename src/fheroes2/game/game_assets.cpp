@@ -24,9 +24,13 @@
 #include <array>
 #include <cassert>
 #include <cmath>
+#include <condition_variable>
 #include <cstddef>
+#include <deque>
 #include <initializer_list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <numeric>
 #include <set>
 #include <stdexcept>
@@ -40,15 +44,20 @@
 #include "exception.h"
 #include "game_language.h"
 #include "h2d.h"
+#include "h2d_file.h"
 #include "icn.h"
 #include "image.h"
 #include "image_tool.h"
+#include "logging.h"
 #include "math_base.h"
+#include "memory_mapped_file.h"
 #include "pal.h"
 #include "rand.h"
 #include "screen.h"
 #include "serialize.h"
 #include "settings.h"
+#include "system.h"
+#include "thread.h"
 #include "til.h"
 #include "tools.h"
 #include "translations.h"
@@ -57,6 +66,7 @@
 #include "ui_language.h"
 #include "ui_text.h"
 #include "ui_tool.h"
+#include "version.h"
 
 namespace
 {
@@ -70,6 +80,24 @@ namespace
 
     std::map<int, std::vector<fheroes2::Sprite>> _icnVsScaledSprite;
 
+    // Usage information of images of an ICN or a TIL to decide which of them should be evicted when the memory limit is exceeded.
+    struct ImageCacheEntry
+    {
+        // Memory used by the images in bytes. It is non-zero only for images which can be evicted.
+        size_t memoryUsage{ 0 };
+
+        // Value of the cache epoch when the images were used last time.
+        uint64_t lastUseEpoch{ 0 };
+    };
+
+    std::vector<ImageCacheEntry> _icnCacheEntries( ICN::LASTICN );
+    std::array<ImageCacheEntry, TIL::LASTTIL> _tilCacheEntries;
+
+    // The epoch is increased on every cache trimming. Images used during the current epoch are never evicted.
+    uint64_t _cacheEpoch{ 1 };
+
+    Assets::ImageCacheStatistics _cacheStatistics;
+
     // Some resources are language dependent. These are mostly buttons with a text of them.
     // Once a user changes a language we have to update resources. To do this we need to clear the existing images.
 
@@ -192,6 +220,61 @@ namespace
         return languageDependentIcnId.count( id ) > 0;
     }
 
+    // These ICNs are modified while generating other ICNs or while changing a language, so they cannot be rebuilt on their own.
+    const std::set<int> nonEvictableIcnId{ ICN::ADVEBTNS,
+                                           ICN::ADVMCO,
+                                           ICN::BUTTON_EVIL_FONT_PRESSED,
+                                           ICN::BUTTON_EVIL_FONT_RELEASED,
+                                           ICN::BUTTON_GOOD_FONT_PRESSED,
+                                           ICN::BUTTON_GOOD_FONT_RELEASED,
+                                           ICN::CASLWIND,
+                                           ICN::CASLXTRA,
+                                           ICN::CELLWIN,
+                                           ICN::CELLWIN_EVIL,
+                                           ICN::CMSECO,
+                                           ICN::DROPLISL,
+                                           ICN::EDITBTNS,
+                                           ICN::FONT,
+                                           ICN::GOLDEN_GRADIENT_FONT,
+                                           ICN::GOLDEN_GRADIENT_LARGE_FONT,
+                                           ICN::GRAY_FONT,
+                                           ICN::GRAY_SMALL_FONT,
+                                           ICN::METALLIC_BORDERED_TEXTBOX_EVIL,
+                                           ICN::MINIMON,
+                                           ICN::MINI_MONSTER_IMAGE,
+                                           ICN::MINI_MONSTER_SHADOW,
+                                           ICN::OBJNDIRT,
+                                           ICN::OBJNSNOW,
+                                           ICN::SILVER_GRADIENT_FONT,
+                                           ICN::SILVER_GRADIENT_LARGE_FONT,
+                                           ICN::SMALFONT,
+                                           ICN::SPELCO,
+                                           ICN::STONEBAK,
+                                           ICN::TROLLMSL,
+                                           ICN::WELLBKG,
+                                           ICN::WHITE_LARGE_FONT,
+                                           ICN::YELLOW_FONT,
+                                           ICN::YELLOW_SMALLFONT };
+
+    // Images of language dependent and scalable ICNs are reset by other means so they are not tracked by the cache.
+    bool isEvictableIcnId( const int id )
+    {
+        return nonEvictableIcnId.count( id ) == 0 && !isLanguageDependentIcnId( id ) && scalableIcnId.count( id ) == 0 && scalableBackgroundIcnId.count( id ) == 0;
+    }
+
+    template <typename T>
+    size_t getImagesMemoryUsage( const std::vector<T> & images )
+    {
+        size_t usage = 0;
+
+        for ( const fheroes2::Image & image : images ) {
+            const size_t layerCount = image.singleLayer() ? 1 : 2;
+            usage += static_cast<size_t>( image.width() ) * static_cast<size_t>( image.height() ) * layerCount;
+        }
+
+        return usage;
+    }
+
     // We have few ICNs which we need to scale to the screen size, like Main Menu and Editor backgrounds.
     bool isScaledToScreenBackgroundImage( const int icnId )
     {
@@ -458,6 +541,129 @@ namespace
 
     OriginalAlphabetPreserver alphabetPreserver;
 
+    // Generated fonts are stored on disk so they are not generated again on every start of the game or a change of a language.
+    // Each cache file contains a key describing the input of the generation. A cache file with a different key is ignored and overwritten.
+    class GeneratedFontCache final
+    {
+    public:
+        GeneratedFontCache( std::string fileName, std::string key, std::vector<int> icnIds )
+            : _filePath( System::concatPath( System::GetDataDirectory( "fheroes2" ), fileName ) )
+            , _key( std::move( key ) )
+            , _icnIds( std::move( icnIds ) )
+        {
+            // Do nothing.
+        }
+
+        // Returns true if all ICNs have been loaded from the cache file.
+        bool load() const
+        {
+            fheroes2::H2DReader reader;
+            if ( !reader.open( _filePath ) ) {
+                // The cache has not been created yet.
+                return false;
+            }
+
+            const std::vector<uint8_t> key = reader.getFile( keyEntryName );
+            if ( std::string( key.begin(), key.end() ) != _key ) {
+                DEBUG_LOG( DBG_GAME, DBG_INFO, "The generated font cache " << _filePath << " is outdated and will be rebuilt." )
+                return false;
+            }
+
+            const std::set<std::string, std::less<>> entryNames = reader.getAllFileNames();
+
+            std::vector<std::vector<fheroes2::Sprite>> icns( _icnIds.size() );
+
+            for ( size_t i = 0; i < _icnIds.size(); ++i ) {
+                const std::vector<uint8_t> count = reader.getFile( _getCountEntryName( _icnIds[i] ) );
+                if ( count.size() != 4 ) {
+                    ERROR_LOG( "The generated font cache " << _filePath << " is corrupted." )
+                    return false;
+                }
+
+                ROStreamBuf countStream( count );
+                icns[i].resize( countStream.getLE32() );
+
+                for ( size_t imageId = 0; imageId < icns[i].size(); ++imageId ) {
+                    const std::string entryName = _getImageEntryName( _icnIds[i], imageId );
+
+                    // Empty images are not stored in the cache.
+                    if ( entryNames.count( entryName ) > 0 && !fheroes2::readImageFromH2D( reader, entryName, icns[i][imageId] ) ) {
+                        ERROR_LOG( "The generated font cache " << _filePath << " is corrupted." )
+                        return false;
+                    }
+                }
+            }
+
+            // Modify the existing fonts only when all of them have been read successfully.
+            for ( size_t i = 0; i < _icnIds.size(); ++i ) {
+                _icnVsSprite[_icnIds[i]] = std::move( icns[i] );
+            }
+
+            return true;
+        }
+
+        void save() const
+        {
+            fheroes2::H2DWriter writer;
+            writer.add( keyEntryName, std::vector<uint8_t>( _key.begin(), _key.end() ) );
+
+            for ( const int icnId : _icnIds ) {
+                const std::vector<fheroes2::Sprite> & images = _icnVsSprite[icnId];
+
+                RWStreamBuf countStream;
+                countStream.putLE32( static_cast<uint32_t>( images.size() ) );
+                writer.add( _getCountEntryName( icnId ), countStream.getRaw( 0 ) );
+
+                for ( size_t imageId = 0; imageId < images.size(); ++imageId ) {
+                    if ( !images[imageId].empty() ) {
+                        fheroes2::writeImageToH2D( writer, _getImageEntryName( icnId, imageId ), images[imageId] );
+                    }
+                }
+            }
+
+            if ( !writer.write( _filePath ) ) {
+                DEBUG_LOG( DBG_GAME, DBG_WARN, "Error writing the file " << _filePath )
+            }
+        }
+
+    private:
+        static constexpr const char * keyEntryName{ "key" };
+
+        const std::string _filePath;
+        const std::string _key;
+        const std::vector<int> _icnIds;
+
+        static std::string _getCountEntryName( const int icnId )
+        {
+            return std::to_string( icnId ) + ".count";
+        }
+
+        static std::string _getImageEntryName( const int icnId, const size_t imageId )
+        {
+            return std::to_string( icnId ) + "_" + std::to_string( imageId ) + ".image";
+        }
+    };
+
+    std::string getGeneratedFontCacheKey( const fheroes2::CodePage codePage, const bool dependsOnOriginalFonts )
+    {
+        // Any change in the font generation code must be accompanied by a change of this version.
+        constexpr int cacheVersion{ 1 };
+
+        std::string key = "fheroes2 " ENGINE_VERSION "." EXPANDDEF( BUILD_VERSION ) ", cache version " + std::to_string( cacheVersion ) + ", code page "
+                          + std::to_string( static_cast<int>( codePage ) );
+
+        if ( dependsOnOriginalFonts ) {
+            // Generated letters are based on the original fonts so the cache must be rebuilt if other game resources are used.
+            for ( const auto & [fileName, ignoreExpansion] : { std::make_pair( "FONT.ICN", false ), std::make_pair( "SMALFONT.ICN", false ),
+                                                                std::make_pair( "FONT.ICN", true ) } ) {
+                const fheroes2::FileData fileData = ::AGG::getFileDataFromAggFile( fileName, ignoreExpansion );
+                key += ", " + std::to_string( fheroes2::calculateCRC32( fileData.data(), fileData.size() ) );
+            }
+        }
+
+        return key;
+    }
+
     // This class is used for situations when we need to remove letter-specific offsets, like when we display single letters in a row,
     // and then restore these offsets within the scope of the code
     class ButtonFontOffsetRestorer final
@@ -656,8 +862,9 @@ namespace
 
     void replacePOLAssetWithSW( const int id, const int assetIndex )
     {
-        const std::vector<uint8_t> & body = ::AGG::getDataFromAggFile( ICN::getIcnFileName( id ), true );
-        ROStreamBuf imageStream( body );
+        const fheroes2::FileData icnData = ::AGG::getFileDataFromAggFile( ICN::getIcnFileName( id ), true );
+        const uint8_t * body = icnData.data();
+        ROStreamBuf imageStream( body, icnData.size() );
 
         imageStream.seek( headerSize + assetIndex * 13 );
 
@@ -668,34 +875,47 @@ namespace
         imageStream >> header2;
         const uint32_t dataSize = header2.offsetData - header1.offsetData;
 
-        const uint8_t * data = body.data() + headerSize + header1.offsetData;
+        const uint8_t * data = body + headerSize + header1.offsetData;
         const uint8_t * dataEnd = data + dataSize;
 
         _icnVsSprite[id][assetIndex] = fheroes2::decodeICNSprite( data, dataEnd, header1 );
     }
 
-    // This function returns true if sprites were successfully loaded from AGG file.
-    // WARNING: this function must be called once - only in the beginning of `loadICN()` function.
-    bool readIcnFromAgg( const int id )
+    enum class IcnDecodingResult : uint8_t
     {
-        // If this assertion blows up then something wrong with your logic and you load resources more than once!
-        assert( _icnVsSprite[id].empty() );
+        SUCCESS,
+        NOT_FOUND,
+        CORRUPTED
+    };
 
-        const std::vector<uint8_t> & body = ::AGG::getDataFromAggFile( ICN::getIcnFileName( id ), false );
+    // Decodes all frames of the given ICN directly from the AGG file data without copying it. The frames are decoded in parallel if a thread pool is provided.
+    // This function does not access any shared data except the AGG file so it can be called from any thread.
+    IcnDecodingResult decodeIcnFromAgg( const int id, std::vector<fheroes2::Sprite> & sprites, uint32_t & corruptedFrameId, MultiThreading::ThreadPool * threadPool )
+    {
+        const fheroes2::FileData icnData = ::AGG::getFileDataFromAggFile( ICN::getIcnFileName( id ), false );
+        const uint8_t * body = icnData.data();
+        const size_t bodySize = icnData.size();
 
-        if ( body.empty() ) {
-            return false;
+        if ( bodySize == 0 ) {
+            return IcnDecodingResult::NOT_FOUND;
         }
 
-        ROStreamBuf imageStream( body );
+        ROStreamBuf imageStream( body, bodySize );
 
         const uint32_t count = imageStream.getLE16();
         const uint32_t blockSize = imageStream.getLE32();
         if ( count == 0 || blockSize == 0 ) {
-            return false;
+            return IcnDecodingResult::NOT_FOUND;
         }
 
-        _icnVsSprite[id].resize( count );
+        struct FrameData
+        {
+            fheroes2::ICNHeader header;
+            const uint8_t * data{ nullptr };
+            const uint8_t * dataEnd{ nullptr };
+        };
+
+        std::vector<FrameData> frames( count );
 
         for ( uint32_t i = 0; i < count; ++i ) {
             imageStream.seek( headerSize + i * 13 );
@@ -716,20 +936,202 @@ namespace
                 dataSize = blockSize - header1.offsetData;
             }
 
-            if ( headerSize + header1.offsetData + dataSize > body.size() ) {
-                // This is a corrupted AGG file.
-                throw fheroes2::InvalidDataResources( "ICN Id " + std::to_string( id ) + ", index " + std::to_string( i )
-                                                      + " is being corrupted. "
-                                                        "Make sure that you own an official version of the game." );
+            if ( headerSize + header1.offsetData + dataSize > bodySize ) {
+                corruptedFrameId = i;
+                return IcnDecodingResult::CORRUPTED;
+            }
+
+            FrameData & frame = frames[i];
+            frame.header = header1;
+            frame.data = body + headerSize + header1.offsetData;
+            frame.dataEnd = frame.data + dataSize;
+        }
+
+        sprites.resize( count );
+
+        const auto decodeFrame = [&frames, &sprites]( const size_t frameId ) {
+            const FrameData & frame = frames[frameId];
+            sprites[frameId] = fheroes2::decodeICNSprite( frame.data, frame.dataEnd, frame.header );
+        };
+
+        if ( threadPool != nullptr && count > 1 ) {
+            threadPool->run( count, decodeFrame );
+        }
+        else {
+            for ( uint32_t i = 0; i < count; ++i ) {
+                decodeFrame( i );
+            }
+        }
+
+        return IcnDecodingResult::SUCCESS;
+    }
+
+    // Decodes ICNs from AGG file in the background. The decoded frames are kept until they are taken by `readIcnFromAgg()`.
+    class AsyncIcnDecoder final : public MultiThreading::AsyncManager
+    {
+    public:
+        AsyncIcnDecoder() = default;
+        AsyncIcnDecoder( const AsyncIcnDecoder & ) = delete;
+
+        ~AsyncIcnDecoder() override = default;
+
+        AsyncIcnDecoder & operator=( const AsyncIcnDecoder & ) = delete;
+
+        void setEnabled( const bool enable )
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            _isEnabled = enable;
+
+            if ( !_isEnabled ) {
+                _tasks.clear();
+                _results.clear();
+            }
+        }
+
+        void pushTask( const int icnId )
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            if ( !_isEnabled || icnId == _currentIcnId || _results.count( icnId ) > 0 || std::find( _tasks.begin(), _tasks.end(), icnId ) != _tasks.end() ) {
+                return;
+            }
+
+            _tasks.push_back( icnId );
+
+            notifyWorker();
+        }
+
+        // Returns false if the ICN has not been requested for decoding. Otherwise waits until its decoding is completed and returns its result.
+        bool takeResult( const int icnId, IcnDecodingResult & result, std::vector<fheroes2::Sprite> & sprites, uint32_t & corruptedFrameId )
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+
+            const auto taskIter = std::find( _tasks.begin(), _tasks.end(), icnId );
+            if ( taskIter != _tasks.end() ) {
+                // The decoding has not been started yet, so there is no reason to wait for it.
+                _tasks.erase( taskIter );
+                return false;
+            }
+
+            _completionNotification.wait( lock, [this, icnId] { return _currentIcnId != icnId; } );
+
+            auto resultIter = _results.find( icnId );
+            if ( resultIter == _results.end() ) {
+                return false;
             }
 
-            const uint8_t * data = body.data() + headerSize + header1.offsetData;
-            const uint8_t * dataEnd = data + dataSize;
+            DecodedIcn & decodedIcn = resultIter->second;
+            result = decodedIcn.result;
+            sprites = std::move( decodedIcn.sprites );
+            corruptedFrameId = decodedIcn.corruptedFrameId;
+
+            _results.erase( resultIter );
+
+            return true;
+        }
+
+        // Must be called when the worker thread is stopped.
+        void releaseThreadPool()
+        {
+            _threadPool.reset();
+        }
+
+    private:
+        struct DecodedIcn
+        {
+            IcnDecodingResult result{ IcnDecodingResult::NOT_FOUND };
+            std::vector<fheroes2::Sprite> sprites;
+            uint32_t corruptedFrameId{ 0 };
+        };
+
+        std::deque<int> _tasks;
+        std::map<int, DecodedIcn> _results;
 
-            _icnVsSprite[id][i] = fheroes2::decodeICNSprite( data, dataEnd, header1 );
+        int _currentIcnId{ ICN::UNKNOWN };
+        DecodedIcn _currentResult;
+
+        std::condition_variable _completionNotification;
+
+        bool _isEnabled{ false };
+
+        // This pool is used only by the worker thread.
+        std::unique_ptr<MultiThreading::ThreadPool> _threadPool;
+
+        bool prepareTask() override
+        {
+            if ( _currentIcnId != ICN::UNKNOWN ) {
+                // The previous task has been executed.
+                if ( _isEnabled ) {
+                    _results.try_emplace( _currentIcnId, std::move( _currentResult ) );
+                }
+
+                _currentResult = {};
+                _currentIcnId = ICN::UNKNOWN;
+
+                _completionNotification.notify_all();
+            }
+
+            if ( _tasks.empty() ) {
+                return false;
+            }
+
+            _currentIcnId = _tasks.front();
+            _tasks.pop_front();
+
+            return true;
+        }
+
+        void executeTask() override
+        {
+            if ( _currentIcnId == ICN::UNKNOWN ) {
+                // There is no task to execute.
+                return;
+            }
+
+            if ( !_threadPool ) {
+                _threadPool = std::make_unique<MultiThreading::ThreadPool>();
+            }
+
+            _currentResult.result = decodeIcnFromAgg( _currentIcnId, _currentResult.sprites, _currentResult.corruptedFrameId, _threadPool.get() );
+        }
+    };
+
+    AsyncIcnDecoder asyncIcnDecoder;
+
+    // This function returns true if sprites were successfully loaded from AGG file.
+    // WARNING: this function must be called once - only in the beginning of `loadICN()` function.
+    bool readIcnFromAgg( const int id )
+    {
+        // If this assertion blows up then something wrong with your logic and you load resources more than once!
+        assert( _icnVsSprite[id].empty() );
+
+        IcnDecodingResult result = IcnDecodingResult::NOT_FOUND;
+        uint32_t corruptedFrameId = 0;
+
+        // Use the frames decoded in the background if this ICN has been prefetched.
+        if ( !asyncIcnDecoder.takeResult( id, result, _icnVsSprite[id], corruptedFrameId ) ) {
+            result = decodeIcnFromAgg( id, _icnVsSprite[id], corruptedFrameId, nullptr );
+        }
+
+        switch ( result ) {
+        case IcnDecodingResult::SUCCESS:
+            return true;
+        case IcnDecodingResult::NOT_FOUND:
+            _icnVsSprite[id].clear();
+            return false;
+        case IcnDecodingResult::CORRUPTED:
+            // This is a corrupted AGG file.
+            throw fheroes2::InvalidDataResources( "ICN Id " + std::to_string( id ) + ", index " + std::to_string( corruptedFrameId )
+                                                  + " is being corrupted. "
+                                                    "Make sure that you own an official version of the game." );
+        default:
+            // Did you add a new decoding result? Add the logic above!
+            assert( 0 );
+            break;
         }
 
-        return true;
+        return false;
     }
 
     // Helper function for processICN
@@ -1657,7 +2059,7 @@ namespace
         }
         case ICN::BUTTONS_NEW_GAME_MENU_GOOD: {
             // Set the size depending on whether PoL assets are present or not, in which case add 4 more for campaign buttons.
-            const bool isPoLPresent = !::AGG::getDataFromAggFile( ICN::getIcnFileName( ICN::X_TRACK1 ), false ).empty();
+            const bool isPoLPresent = ( ::AGG::getFileDataFromAggFile( ICN::getIcnFileName( ICN::X_TRACK1 ), false ).size() > 0 );
             if ( isPoLPresent ) {
                 _icnVsSprite[id].resize( 28 );
             }
@@ -2092,7 +2494,7 @@ namespace
     {
         switch ( id ) {
         case ICN::BUTTONS_NEW_GAME_MENU_GOOD: {
-            const bool isPoLPresent = !::AGG::getDataFromAggFile( ICN::getIcnFileName( ICN::X_TRACK1 ), false ).empty();
+            const bool isPoLPresent = ( ::AGG::getFileDataFromAggFile( ICN::getIcnFileName( ICN::X_TRACK1 ), false ).size() > 0 );
             if ( isPoLPresent ) {
                 _icnVsSprite[id].resize( 28 );
             }
@@ -2312,7 +2714,7 @@ namespace
     {
         switch ( id ) {
         case ICN::BUTTONS_NEW_GAME_MENU_GOOD: {
-            const bool isPoLPresent = !::AGG::getDataFromAggFile( ICN::getIcnFileName( ICN::X_TRACK1 ), false ).empty();
+            const bool isPoLPresent = ( ::AGG::getFileDataFromAggFile( ICN::getIcnFileName( ICN::X_TRACK1 ), false ).size() > 0 );
             if ( isPoLPresent ) {
                 _icnVsSprite[id].resize( 28 );
             }
@@ -2480,8 +2882,8 @@ namespace
                 throw std::logic_error( "The game resources are corrupted. Please use resources from a licensed version of Heroes of Might and Magic II." );
             }
 
-            const std::vector<uint8_t> & body = ::AGG::getDataFromAggFile( ICN::getIcnFileName( id ), false );
-            const uint32_t crc32 = fheroes2::calculateCRC32( body.data(), body.size() );
+            const fheroes2::FileData icnData = ::AGG::getFileDataFromAggFile( ICN::getIcnFileName( id ), false );
+            const uint32_t crc32 = fheroes2::calculateCRC32( icnData.data(), icnData.size() );
 
             if ( id == ICN::SMALFONT ) {
                 // Small font in official Polish GoG version has all letters shifted 1 pixel down.
@@ -3459,7 +3861,7 @@ namespace
 
                 // Since we cannot access game settings from here we are checking an existence
                 // of one of POL resources as an indicator for this version.
-                if ( !::AGG::getDataFromAggFile( ICN::getIcnFileName( ICN::X_TRACK1 ), false ).empty() ) {
+                if ( ::AGG::getFileDataFromAggFile( ICN::getIcnFileName( ICN::X_TRACK1 ), false ).size() > 0 ) {
                     fheroes2::Sprite editorIcon;
                     fheroes2::h2d::readImage( "main_menu_editor_icon.image", editorIcon );
 
@@ -5658,11 +6060,16 @@ namespace
 
     void loadICN( const int id )
     {
+        _icnCacheEntries[id].lastUseEpoch = _cacheEpoch;
+
         if ( !_icnVsSprite[id].empty() ) {
             // The images have been loaded.
+            ++_cacheStatistics.hits;
             return;
         }
 
+        ++_cacheStatistics.misses;
+
         // Some images contain text. This text should be adapted to a chosen language.
         if ( isLanguageDependentIcnId( id ) ) {
             generateLanguageSpecificImages( id );
@@ -5686,6 +6093,14 @@ namespace
             // In order to avoid subsequent attempts to get resources from this ICN we are making it as non-empty.
             _icnVsSprite[id].resize( 1 );
         }
+
+        if ( isEvictableIcnId( id ) ) {
+            ImageCacheEntry & entry = _icnCacheEntries[id];
+            assert( entry.memoryUsage == 0 );
+
+            entry.memoryUsage = getImagesMemoryUsage( _icnVsSprite[id] );
+            _cacheStatistics.memoryUsage += entry.memoryUsage;
+        }
     }
 
     size_t GetMaximumICNIndex( const int id )
@@ -5699,27 +6114,33 @@ namespace
     {
         auto & tilImages = _tilVsImage[id];
 
+        _tilCacheEntries[id].lastUseEpoch = _cacheEpoch;
+
         if ( tilImages.empty() ) {
+            ++_cacheStatistics.misses;
+
             tilImages.resize( 4 ); // 4 possible sides
 
-            const std::vector<uint8_t> & data = ::AGG::getDataFromAggFile( tilFileName[id], false );
-            if ( data.size() < headerSize ) {
+            const fheroes2::FileData tilData = ::AGG::getFileDataFromAggFile( tilFileName[id], false );
+            const uint8_t * data = tilData.data();
+            const size_t dataSize = tilData.size();
+            if ( dataSize < headerSize ) {
                 // The important resource is absent! Make sure that you are using the correct version of the game.
                 assert( 0 );
                 return 0;
             }
 
-            ROStreamBuf buffer( data );
+            ROStreamBuf buffer( data, dataSize );
 
             const size_t count = buffer.getLE16();
             const int32_t width = buffer.getLE16();
             const int32_t height = buffer.getLE16();
-            if ( count < 1 || width < 1 || height < 1 || ( headerSize + count * width * height ) != data.size() ) {
+            if ( count < 1 || width < 1 || height < 1 || ( headerSize + count * width * height ) != dataSize ) {
                 return 0;
             }
 
             std::vector<fheroes2::Image> & originalTIL = tilImages[0];
-            decodeTILImages( data.data() + headerSize, count, width, height, originalTIL );
+            decodeTILImages( data + headerSize, count, width, height, originalTIL );
 
             for ( uint32_t shapeId = 1; shapeId < 4; ++shapeId ) {
                 tilImages[shapeId].resize( count );
@@ -5738,6 +6159,18 @@ namespace
                     Flip( originalTIL[i], 0, 0, image, 0, 0, width, height, horizontalFlip, verticalFlip );
                 }
             }
+
+            ImageCacheEntry & entry = _tilCacheEntries[id];
+            assert( entry.memoryUsage == 0 );
+
+            for ( const std::vector<fheroes2::Image> & images : tilImages ) {
+                entry.memoryUsage += getImagesMemoryUsage( images );
+            }
+
+            _cacheStatistics.memoryUsage += entry.memoryUsage;
+        }
+        else {
+            ++_cacheStatistics.hits;
         }
 
         return tilImages[0].size();
@@ -5843,6 +6276,8 @@ namespace Assets
         static bool areOriginalResourcesInUse = false;
         static fheroes2::CodePage currentCodePage{ fheroes2::CodePage::NONE };
 
+        const fheroes2::CodePage codePage = fheroes2::getCodePage( language );
+
         if ( loadOriginalAlphabet ) {
             if ( alphabetPreserver.isPreserved() ) {
                 if ( areOriginalResourcesInUse ) {
@@ -5859,7 +6294,7 @@ namespace Assets
             }
         }
         else {
-            if ( !areOriginalResourcesInUse && currentCodePage == fheroes2::getCodePage( language ) ) {
+            if ( !areOriginalResourcesInUse && currentCodePage == codePage ) {
                 // We are trying to load resources for the same code page. We don't need to redo the same work again.
                 return;
             }
@@ -5868,20 +6303,115 @@ namespace Assets
             // Restore original letters when changing language to avoid changes to them being carried over.
             alphabetPreserver.restore();
 
-            fheroes2::generateAlphabet( language, _icnVsSprite );
+            const GeneratedFontCache alphabetCache( "alphabet_" + std::to_string( static_cast<int>( codePage ) ) + ".h2d", getGeneratedFontCacheKey( codePage, true ),
+                                                    { ICN::FONT, ICN::SMALFONT } );
+
+            if ( !alphabetCache.load() ) {
+                fheroes2::generateAlphabet( language, _icnVsSprite );
+                alphabetCache.save();
+            }
         }
 
-        fheroes2::generateButtonAlphabet( language, _icnVsSprite );
+        const GeneratedFontCache buttonAlphabetCache( "button_alphabet_" + std::to_string( static_cast<int>( codePage ) ) + ".h2d",
+                                                      getGeneratedFontCacheKey( codePage, false ),
+                                                      { ICN::BUTTON_GOOD_FONT_RELEASED, ICN::BUTTON_GOOD_FONT_PRESSED, ICN::BUTTON_EVIL_FONT_RELEASED,
+                                                        ICN::BUTTON_EVIL_FONT_PRESSED } );
+
+        if ( !buttonAlphabetCache.load() ) {
+            fheroes2::generateButtonAlphabet( language, _icnVsSprite );
+            buttonAlphabetCache.save();
+        }
 
         // Clear language dependent resources.
         for ( const int id : languageDependentIcnId ) {
             _icnVsSprite[id].clear();
         }
 
-        currentCodePage = fheroes2::getCodePage( language );
+        currentCodePage = codePage;
         areOriginalResourcesInUse = loadOriginalAlphabet;
     }
 
+    void prefetchImages( const std::vector<int> & icnIds )
+    {
+        for ( const int id : icnIds ) {
+            if ( !IsValidICNId( id ) || id >= ICN::LAST_VALID_FILE_ICN || !_icnVsSprite[id].empty() || isLanguageDependentIcnId( id ) ) {
+                // Only the original ICNs that have not been loaded yet are decoded in the background.
+                continue;
+            }
+
+            asyncIcnDecoder.pushTask( id );
+        }
+    }
+
+    PrefetchInitializer::PrefetchInitializer()
+    {
+        asyncIcnDecoder.createWorker();
+        asyncIcnDecoder.setEnabled( true );
+    }
+
+    PrefetchInitializer::~PrefetchInitializer()
+    {
+        asyncIcnDecoder.setEnabled( false );
+        asyncIcnDecoder.stopWorker();
+        asyncIcnDecoder.releaseThreadPool();
+    }
+
+    void trimImageCache( const size_t memoryLimit )
+    {
+        if ( memoryLimit > 0 && _cacheStatistics.memoryUsage > memoryLimit ) {
+            // Images of ICNs and TILs are sorted by the time of their last use. TILs have negative identifiers here.
+            std::vector<std::pair<uint64_t, int>> candidates;
+
+            for ( size_t icnId = 0; icnId < _icnCacheEntries.size(); ++icnId ) {
+                const ImageCacheEntry & entry = _icnCacheEntries[icnId];
+                if ( entry.memoryUsage > 0 && entry.lastUseEpoch < _cacheEpoch ) {
+                    candidates.emplace_back( entry.lastUseEpoch, static_cast<int>( icnId ) );
+                }
+            }
+
+            for ( size_t tilId = 0; tilId < _tilCacheEntries.size(); ++tilId ) {
+                const ImageCacheEntry & entry = _tilCacheEntries[tilId];
+                if ( entry.memoryUsage > 0 && entry.lastUseEpoch < _cacheEpoch ) {
+                    candidates.emplace_back( entry.lastUseEpoch, -1 - static_cast<int>( tilId ) );
+                }
+            }
+
+            std::sort( candidates.begin(), candidates.end() );
+
+            for ( const auto & [lastUseEpoch, id] : candidates ) {
+                if ( _cacheStatistics.memoryUsage <= memoryLimit ) {
+                    break;
+                }
+
+                ImageCacheEntry * entry = nullptr;
+
+                if ( id >= 0 ) {
+                    entry = &_icnCacheEntries[id];
+                    _icnVsSprite[id].clear();
+                }
+                else {
+                    const int tilId = -1 - id;
+                    entry = &_tilCacheEntries[tilId];
+                    _tilVsImage[tilId].clear();
+                }
+
+                assert( _cacheStatistics.memoryUsage >= entry->memoryUsage );
+
+                _cacheStatistics.memoryUsage -= entry->memoryUsage;
+                entry->memoryUsage = 0;
+
+                ++_cacheStatistics.evictions;
+            }
+        }
+
+        ++_cacheEpoch;
+    }
+
+    const ImageCacheStatistics & getImageCacheStatistics()
+    {
+        return _cacheStatistics;
+    }
+
     void resetAllScaledImages()
     {
         for ( const int icnId : scalableIcnId ) {
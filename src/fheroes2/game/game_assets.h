@@ -20,7 +20,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 namespace fheroes2
 {
@@ -41,6 +43,43 @@ namespace Assets
     // This function must be called only at the time of setting up a new language.
     void updateLanguageDependentResources( const fheroes2::SupportedLanguage language, const bool loadOriginalAlphabet );
 
+    // Starts decoding of the given ICNs in the background so a screen can request the images it is going to use in advance.
+    // `getImage()` waits for the background decoding of an ICN only if it has been started but not completed yet.
+    void prefetchImages( const std::vector<int> & icnIds );
+
+    // Background decoding is available only during the lifetime of an object of this class. It must not outlive AGG files.
+    class PrefetchInitializer final
+    {
+    public:
+        PrefetchInitializer();
+        PrefetchInitializer( const PrefetchInitializer & ) = delete;
+        PrefetchInitializer & operator=( const PrefetchInitializer & ) = delete;
+
+        ~PrefetchInitializer();
+    };
+
+    struct ImageCacheStatistics
+    {
+        // The number of requests of already loaded images.
+        uint64_t hits{ 0 };
+
+        // The number of requests which required images to be loaded or generated.
+        uint64_t misses{ 0 };
+
+        // The number of ICNs and TILs which images have been evicted.
+        uint64_t evictions{ 0 };
+
+        // Memory in bytes used by all loaded images which can be evicted.
+        size_t memoryUsage{ 0 };
+    };
+
+    // Frees images of the least recently used ICNs and TILs until the memory used by evictable images fits into the given limit (0 means no limit).
+    // Only images which can be rebuilt on demand are evicted and images requested since the previous call are always kept.
+    // References to images obtained before this call must not be used after it, so call it only where no such references are held.
+    void trimImageCache( const size_t memoryLimit );
+
+    const ImageCacheStatistics & getImageCacheStatistics();
+
     void resetAllScaledImages();
     void resetScaledBackgroundImages();
 }
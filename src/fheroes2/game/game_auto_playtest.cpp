@@ -20,12 +20,22 @@
 
 #include "game_auto_playtest.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cctype>
 #include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
 #include <map>
 #include <memory>
+#include <ostream>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include "ai_planner.h"
 #include "audio.h"
 #include "audio_manager.h"
 #include "color.h"
@@ -35,32 +45,32 @@
 #include "game_assets.h"
 #include "game_delays.h"
 #include "game_hotkeys.h"
+#include "game_mode.h"
+#include "game_over.h"
 #include "icn.h"
 #include "image.h"
+#include "kingdom.h"
 #include "localevent.h"
+#include "logging.h"
 #include "maps_fileinfo.h"
 #include "math_base.h"
 #include "mus.h"
 #include "pal.h"
 #include "players.h"
+#include "rand.h"
 #include "screen.h"
 #include "settings.h"
 #include "tools.h"
 #include "translations.h"
 #include "ui_button.h"
 #include "ui_dialog.h"
+#include "ui_language.h"
 #include "ui_slider.h"
 #include "ui_text.h"
 #include "ui_tool.h"
 #include "ui_window.h"
 #include "world.h"
 
-#if defined( WITH_DEBUG )
-#include <ostream>
-
-#include "logging.h"
-#endif
-
 namespace
 {
     constexpr int32_t sliderWidth{ 150 };
@@ -324,6 +334,378 @@ namespace
         Game::UpdateGameSpeed();
     }
 
+    // Plays the current map from the first day till its end without touching the Adventure Map interface.
+    // The order of turns and the player setup are the same as in the regular auto playtest.
+    void runHeadlessPlaythrough()
+    {
+        Settings & conf = Settings::Get();
+
+        GameOver::Result & gameResult = GameOver::Result::Get();
+        gameResult.Reset();
+
+        std::vector<Player *> sortedPlayers = conf.GetPlayers().getVector();
+        std::sort( sortedPlayers.begin(), sortedPlayers.end(), []( const Player * player1, const Player * player2 ) {
+            return ( player1->isControlHuman() && !player2->isControlHuman() )
+                   || ( ( player1->isControlHuman() == player2->isControlHuman() ) && ( player1->GetColor() < player2->GetColor() ) );
+        } );
+
+        for ( Player * player : sortedPlayers ) {
+            world.ClearFog( player->GetColor() );
+
+            // Every player for auto playtest mode is set as human player controlled by AI.
+            player->SetControl( CONTROL_HUMAN );
+            player->setAIAutoControlMode( true );
+        }
+
+        auto & autoPlaytest = fheroes2::AutoPlaytest::instance();
+
+        while ( true ) {
+            world.NewDay();
+
+            // Check if the game is over at the beginning of a new day.
+            if ( gameResult.checkGameOver() != fheroes2::GameMode::CANCEL ) {
+                break;
+            }
+
+            if ( static_cast<int32_t>( world.CountDay() ) > autoPlaytest.getMaxDaysInPlaythrough() ) {
+                autoPlaytest.markTimeLimit();
+                break;
+            }
+
+            bool isGameOver = false;
+
+            for ( const Player * player : sortedPlayers ) {
+                assert( player != nullptr );
+
+                const PlayerColor playerColor = player->GetColor();
+                Kingdom & kingdom = world.GetKingdom( playerColor );
+
+                if ( !kingdom.isPlay() ) {
+                    continue;
+                }
+
+                conf.SetCurrentColor( playerColor );
+
+                kingdom.ActionNewDayResourceUpdate( nullptr );
+                kingdom.ActionBeforeTurn();
+
+                // Check if the game is over after each player's turn.
+                if ( AI::Planner::Get().KingdomTurn( kingdom ) != fheroes2::GameMode::END_TURN || gameResult.checkGameOver() != fheroes2::GameMode::CANCEL ) {
+                    isGameOver = true;
+                    break;
+                }
+            }
+
+            // Don't carry the current player color to the next turn.
+            conf.SetCurrentColor( PlayerColor::NONE );
+
+            if ( isGameOver ) {
+                break;
+            }
+        }
+    }
+
+    const char * getPlayerStateString( const fheroes2::AutoPlaytest::PlayerState state )
+    {
+        switch ( state ) {
+        case fheroes2::AutoPlaytest::PlayerState::WINNER:
+            return "winner";
+        case fheroes2::AutoPlaytest::PlayerState::LOSER:
+            return "loser";
+        case fheroes2::AutoPlaytest::PlayerState::TIME_LIMIT:
+            return "time_limit";
+        case fheroes2::AutoPlaytest::PlayerState::INTERRUPTED:
+            return "interrupted";
+        default:
+            // Did you add a new state?
+            assert( 0 );
+            break;
+        }
+
+        return "unknown";
+    }
+
+    bool getPlayerStateFromString( const std::string_view value, fheroes2::AutoPlaytest::PlayerState & state )
+    {
+        for ( const auto playerState : { fheroes2::AutoPlaytest::PlayerState::WINNER, fheroes2::AutoPlaytest::PlayerState::LOSER,
+                                         fheroes2::AutoPlaytest::PlayerState::TIME_LIMIT, fheroes2::AutoPlaytest::PlayerState::INTERRUPTED } ) {
+            if ( value == getPlayerStateString( playerState ) ) {
+                state = playerState;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool getPlayerColorFromString( const std::string_view value, PlayerColor & color )
+    {
+        for ( const PlayerColor playerColor : PlayerColorsVector( Color::allPlayerColors() ) ) {
+            if ( value == Color::String( playerColor ) ) {
+                color = playerColor;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void writePlaythroughResults( const std::vector<std::vector<fheroes2::AutoPlaytest::PlayerInfo>> & results, const int32_t firstPlaythroughId,
+                                  std::ostream & output )
+    {
+        output << "playthrough,color,state,day\n";
+
+        for ( size_t i = 0; i < results.size(); ++i ) {
+            for ( const fheroes2::AutoPlaytest::PlayerInfo & info : results[i] ) {
+                output << static_cast<size_t>( firstPlaythroughId ) + i + 1 << ',' << Color::String( info.color ) << ',' << getPlayerStateString( info.state ) << ','
+                       << info.dayOfState << '\n';
+            }
+        }
+    }
+
+    // The summary is written as comment lines to keep the output a valid CSV file.
+    void writeSummary( const std::vector<std::vector<fheroes2::AutoPlaytest::PlayerInfo>> & results, std::ostream & output )
+    {
+        struct PlayerSummary
+        {
+            int32_t wins{ 0 };
+            int32_t losses{ 0 };
+            int32_t timeLimits{ 0 };
+            uint64_t totalDayOfDefeat{ 0 };
+        };
+
+        std::map<PlayerColor, PlayerSummary> summaries;
+
+        for ( const auto & result : results ) {
+            for ( const auto & info : result ) {
+                PlayerSummary & summary = summaries[info.color];
+
+                switch ( info.state ) {
+                case fheroes2::AutoPlaytest::PlayerState::WINNER:
+                    ++summary.wins;
+                    break;
+                case fheroes2::AutoPlaytest::PlayerState::LOSER:
+                    ++summary.losses;
+                    summary.totalDayOfDefeat += info.dayOfState;
+                    break;
+                case fheroes2::AutoPlaytest::PlayerState::TIME_LIMIT:
+                    ++summary.timeLimits;
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+
+        const size_t playthroughCount = std::max<size_t>( results.size(), 1 );
+
+        output << "# playthroughs: " << results.size() << '\n';
+        output << "# color,wins,win_rate,losses,average_day_of_defeat,time_limits\n";
+
+        for ( const auto & [color, summary] : summaries ) {
+            output << "# " << Color::String( color ) << ',' << summary.wins << ',' << static_cast<size_t>( summary.wins ) * 100 / playthroughCount << "%," << summary.losses
+                   << ',' << ( summary.losses > 0 ? summary.totalDayOfDefeat / static_cast<uint64_t>( summary.losses ) : 0 ) << ',' << summary.timeLimits << '\n';
+        }
+    }
+
+    bool runHeadlessPlaythroughs( const fheroes2::HeadlessAutoPlaytestOptions & options, std::vector<std::vector<fheroes2::AutoPlaytest::PlayerInfo>> & results )
+    {
+        assert( options.seed );
+
+        Maps::FileInfo mapInfo;
+        if ( !mapInfo.readResurrectionMap( options.mapFilePath, false, fheroes2::getCurrentLanguage() ) ) {
+            ERROR_LOG( "Failed to read the map file " << options.mapFilePath << " for headless auto playtest." )
+            return false;
+        }
+
+        if ( mapInfo.colorsAvailableForHumans == 0 ) {
+            ERROR_LOG( "The map " << options.mapFilePath << " is not playable as it has no human players." )
+            return false;
+        }
+
+        Settings & conf = Settings::Get();
+        conf.setCurrentMapInfo( std::move( mapInfo ) );
+
+        auto & autoPlaytest = fheroes2::AutoPlaytest::instance();
+        autoPlaytest.enableHeadlessMode();
+        autoPlaytest.setMaxDaysInPlaythrough( options.maxDays );
+
+        // There is nothing to show so AI moves are never delayed.
+        conf.SetAIMoveSpeed( 0 );
+        Game::UpdateGameSpeed();
+        Game::SetUpdateSoundsOnFocusUpdate( false );
+
+        for ( int32_t i = 0; i < options.playthroughCount; ++i ) {
+            // Every playthrough is fully defined by its own seed no matter which process or in which order runs it.
+            Rand::CurrentThreadRandomDevice() = Rand::PCG32( static_cast<uint64_t>( *options.seed ) + static_cast<uint64_t>( options.firstPlaythroughId + i ) );
+
+            if ( !prepareMap() ) {
+                ERROR_LOG( "Failed to prepare the map " << options.mapFilePath << " for headless auto playtest." )
+                return false;
+            }
+
+            if ( i == 0 ) {
+                autoPlaytest.reset( conf.GetPlayers().GetColors() );
+            }
+            else {
+                autoPlaytest.nextPlaythrough();
+            }
+
+            conf.SetGameType( Game::TYPE_AUTO_PLAYTEST );
+
+            runHeadlessPlaythrough();
+        }
+
+        results = autoPlaytest.getResults();
+
+        return true;
+    }
+
+    // Quotes the argument so that the platform shell passes it to the started process as is.
+    std::string quoteCommandArgument( const std::string & argument )
+    {
+#if defined( _WIN32 )
+        // Backslashes are literal unless they precede a double quote. Such backslashes and the double quote itself must be escaped
+        // by backslashes, including the backslashes before the closing double quote.
+        std::string quoted( 1, '"' );
+        size_t backslashCount = 0;
+
+        for ( const char c : argument ) {
+            if ( c == '\\' ) {
+                ++backslashCount;
+                continue;
+            }
+
+            quoted.append( c == '"' ? backslashCount * 2 + 1 : backslashCount, '\\' );
+            quoted += c;
+
+            backslashCount = 0;
+        }
+
+        quoted.append( backslashCount * 2, '\\' );
+        quoted += '"';
+
+        return quoted;
+#else
+        // Nothing is interpreted inside single quotes, so every single quote has to close the quoting, be escaped and reopen it.
+        std::string quoted( 1, '\'' );
+
+        for ( const char c : argument ) {
+            if ( c == '\'' ) {
+                quoted += "'\\''";
+            }
+            else {
+                quoted += c;
+            }
+        }
+
+        quoted += '\'';
+
+        return quoted;
+#endif
+    }
+
+    // Every worker is a separate process of the game running in the headless mode, since the world, the settings and
+    // the AI planner are singletons which cannot be shared between concurrently running playthroughs.
+    bool runPlaythroughsInWorkers( const fheroes2::HeadlessAutoPlaytestOptions & options, std::vector<std::vector<fheroes2::AutoPlaytest::PlayerInfo>> & results )
+    {
+#if defined( ANDROID ) || defined( TARGET_PS_VITA ) || defined( TARGET_NINTENDO_SWITCH ) || defined( __IPHONEOS__ ) || defined( __EMSCRIPTEN__ )
+        ERROR_LOG( "Worker processes are not supported on this platform. All playthroughs are run in the current process." )
+
+        return runHeadlessPlaythroughs( options, results );
+#else
+        assert( options.seed && options.jobCount > 1 );
+
+        const int32_t jobCount = std::min( options.jobCount, options.playthroughCount );
+
+        std::vector<FILE *> workers;
+        workers.reserve( static_cast<size_t>( jobCount ) );
+
+        for ( int32_t job = 0; job < jobCount; ++job ) {
+            // Split playthroughs into contiguous ranges of almost the same size.
+            const int32_t first = options.playthroughCount * job / jobCount;
+            const int32_t last = options.playthroughCount * ( job + 1 ) / jobCount;
+
+            std::string command = quoteCommandArgument( options.executablePath ) + " --autoplaytest " + quoteCommandArgument( options.mapFilePath ) + " --playthroughs "
+                                  + std::to_string( last - first ) + " --first-playthrough " + std::to_string( options.firstPlaythroughId + first ) + " --days "
+                                  + std::to_string( options.maxDays ) + " --seed " + std::to_string( *options.seed ) + " --worker";
+
+#if defined( _WIN32 )
+            // The command interpreter strips the outermost quotes of the command.
+            command = '"' + command + '"';
+
+            FILE * worker = _popen( command.c_str(), "r" );
+#else
+            FILE * worker = popen( command.c_str(), "r" );
+#endif
+            if ( worker == nullptr ) {
+                ERROR_LOG( "Failed to start a worker process: " << command )
+                break;
+            }
+
+            workers.push_back( worker );
+        }
+
+        std::map<int32_t, std::vector<fheroes2::AutoPlaytest::PlayerInfo>> playthroughs;
+        bool isValid = ( static_cast<int32_t>( workers.size() ) == jobCount );
+
+        for ( FILE * worker : workers ) {
+            std::string line;
+            std::array<char, 256> buffer{};
+
+            while ( std::fgets( buffer.data(), static_cast<int>( buffer.size() ), worker ) != nullptr ) {
+                line += buffer.data();
+                if ( line.empty() || line.back() != '\n' ) {
+                    continue;
+                }
+
+                line.pop_back();
+
+                // Skip the header and comments.
+                if ( !line.empty() && std::isdigit( static_cast<unsigned char>( line.front() ) ) ) {
+                    const std::vector<std::string> values = StringSplit( line, ',' );
+
+                    fheroes2::AutoPlaytest::PlayerInfo info;
+
+                    if ( values.size() != 4 || !getPlayerColorFromString( values[1], info.color ) || !getPlayerStateFromString( values[2], info.state ) ) {
+                        ERROR_LOG( "Invalid worker output: " << line )
+                        isValid = false;
+                    }
+                    else {
+                        info.dayOfState = static_cast<uint32_t>( std::strtoul( values[3].c_str(), nullptr, 10 ) );
+                        playthroughs[std::atoi( values[0].c_str() )].push_back( info );
+                    }
+                }
+
+                line.clear();
+            }
+
+#if defined( _WIN32 )
+            const int exitCode = _pclose( worker );
+#else
+            const int exitCode = pclose( worker );
+#endif
+            if ( exitCode != 0 ) {
+                ERROR_LOG( "A worker process has failed with the exit code " << exitCode )
+                isValid = false;
+            }
+        }
+
+        if ( !isValid || static_cast<int32_t>( playthroughs.size() ) != options.playthroughCount ) {
+            return false;
+        }
+
+        results.clear();
+        results.reserve( playthroughs.size() );
+
+        for ( auto & [playthroughId, infos] : playthroughs ) {
+            results.emplace_back( std::move( infos ) );
+        }
+
+        return true;
+#endif
+    }
+
     std::string getValueString( const int32_t value, const int32_t limit )
     {
         return std::to_string( value ) + '/' + std::to_string( limit );
@@ -558,4 +940,35 @@ namespace fheroes2
 
         autoPlaytest.interrupt( world.CountDay() );
     }
+
+    bool runHeadlessAutoPlaytest( const HeadlessAutoPlaytestOptions & options, std::ostream & output )
+    {
+        HeadlessAutoPlaytestOptions updatedOptions{ options };
+        if ( !updatedOptions.seed ) {
+            // All playthroughs must be seeded by the same base seed even if they are run by different processes.
+            updatedOptions.seed = Rand::Get( std::numeric_limits<uint32_t>::max() );
+        }
+
+        std::vector<std::vector<AutoPlaytest::PlayerInfo>> results;
+
+        if ( updatedOptions.jobCount > 1 && updatedOptions.playthroughCount > 1 ) {
+            if ( !runPlaythroughsInWorkers( updatedOptions, results ) ) {
+                return false;
+            }
+        }
+        else if ( !runHeadlessPlaythroughs( updatedOptions, results ) ) {
+            return false;
+        }
+
+        writePlaythroughResults( results, updatedOptions.firstPlaythroughId, output );
+
+        if ( !updatedOptions.isWorker ) {
+            output << "# seed: " << *updatedOptions.seed << '\n';
+            writeSummary( results, output );
+        }
+
+        output.flush();
+
+        return true;
+    }
 }
@@ -23,6 +23,9 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -104,6 +107,19 @@ namespace fheroes2
             return _playEnvironmentSounds;
         }
 
+        // In the headless mode nothing is rendered and no sounds are played.
+        void enableHeadlessMode()
+        {
+            _isHeadless = true;
+            _isAnimationEnabled = false;
+            _playEnvironmentSounds = false;
+        }
+
+        bool isHeadless() const
+        {
+            return _isHeadless;
+        }
+
         void reset( const PlayerColorsSet colors )
         {
             _playthroughResults.clear();
@@ -198,9 +214,38 @@ namespace fheroes2
         int32_t _animationSpeed{ animationLimit };
         bool _isAnimationEnabled{ true };
         bool _playEnvironmentSounds{ true };
+        bool _isHeadless{ false };
     };
 
     bool openMapAutoPlayTest();
 
     void interruptAutoPlaytest();
+
+    struct HeadlessAutoPlaytestOptions final
+    {
+        static constexpr int32_t playthroughLimit{ 100000 };
+
+        std::string mapFilePath;
+
+        // Used to start worker processes.
+        std::string executablePath;
+
+        int32_t playthroughCount{ 1 };
+        int32_t firstPlaythroughId{ 0 };
+        int32_t maxDays{ 365 };
+
+        // Playthrough with ID N is seeded by 'seed + N'. A random seed is chosen if it is not set.
+        std::optional<uint32_t> seed;
+
+        // The number of worker processes to run playthroughs concurrently.
+        int32_t jobCount{ 1 };
+
+        // Workers output only the results of their playthroughs without the summary.
+        bool isWorker{ false };
+    };
+
+    // Runs AI-only playthroughs of the given Resurrection map without any window, audio device or rendering and
+    // writes the results of every player in every playthrough followed by the summary to the output as CSV.
+    // Returns false if the map cannot be played or any of the workers failed.
+    bool runHeadlessAutoPlaytest( const HeadlessAutoPlaytestOptions & options, std::ostream & output );
 }
@@ -25,6 +25,7 @@
 #include <list>
 #include <memory>
 #include <ostream>
+#include <set>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -40,6 +41,7 @@
 #include "game_delays.h"
 #include "game_exit.h"
 #include "game_hotkeys.h"
+#include "game_io.h"
 #include "game_invalid_assets.h"
 #include "game_mode.h"
 #include "h2d.h"
@@ -149,6 +151,8 @@ namespace
 
                 _h2dInitializer = std::make_unique<fheroes2::h2d::H2DInitializer>();
 
+                _prefetchInitializer = std::make_unique<Assets::PrefetchInitializer>();
+
                 // Verify that the font is present and it is not corrupted.
                 Assets::getImage( ICN::FONT, 0 );
             }
@@ -176,6 +180,9 @@ namespace
     private:
         std::unique_ptr<AGG::AGGInitializer> _aggInitializer;
         std::unique_ptr<fheroes2::h2d::H2DInitializer> _h2dInitializer;
+
+        // This member must be destroyed before AGG files are closed.
+        std::unique_ptr<Assets::PrefetchInitializer> _prefetchInitializer;
     };
 }
 
@@ -266,6 +273,11 @@ namespace Game
         return std::make_unique<System::CoreInitializer>();
     }
 
+    std::unique_ptr<ComponentBase> createHeadlessCoreComponent()
+    {
+        return std::make_unique<System::CoreInitializer>( std::set<System::SystemInitializationComponent>{} );
+    }
+
     std::unique_ptr<ComponentBase> createDisplayComponent()
     {
         return std::make_unique<DisplayInitializer>();
@@ -276,6 +288,11 @@ namespace Game
         return std::make_unique<DataInitializer>();
     }
 
+    std::unique_ptr<ComponentBase> createSaveWriterComponent()
+    {
+        return std::make_unique<AsyncSaveInitializer>();
+    }
+
     std::unique_ptr<ComponentBase> createAudioComponent( const ComponentBase * dataComponent )
     {
         const DataInitializer * dataInitializer = dynamic_cast<const DataInitializer *>( dataComponent );
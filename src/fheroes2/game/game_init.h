@@ -50,9 +50,15 @@ namespace Game
 
     std::unique_ptr<ComponentBase> createCoreComponent();
 
+    // Core component without video and audio subsystems to be used for headless runs.
+    std::unique_ptr<ComponentBase> createHeadlessCoreComponent();
+
     std::unique_ptr<ComponentBase> createDisplayComponent();
 
     std::unique_ptr<ComponentBase> createDataComponent();
 
     std::unique_ptr<ComponentBase> createAudioComponent( const ComponentBase * dataComponent );
+
+    // Saved games are written to the disk in the background while this component exists.
+    std::unique_ptr<ComponentBase> createSaveWriterComponent();
 }
@@ -122,6 +122,12 @@ Interface::AdventureMap & Interface::AdventureMap::Get()
 
 void Interface::AdventureMap::redraw( const uint32_t force )
 {
+    if ( fheroes2::AutoPlaytest::instance().isHeadless() ) {
+        // Nothing is rendered in the headless auto playtest mode.
+        _redraw = 0;
+        return;
+    }
+
     if ( _lockRedraw ) {
         setRedraw( force );
         return;
@@ -141,6 +147,15 @@ void Interface::AdventureMap::redraw( const uint32_t force )
             _controlPanel._redraw();
         }
     }
+    else if ( combinedRedraw & REDRAW_GAMEAREA_CHANGES ) {
+        if ( !conf.IsGameType( Game::TYPE_AUTO_PLAYTEST ) || fheroes2::AutoPlaytest::instance().isAnimationEnabled() ) {
+            _gameArea.redrawChangedTiles( fheroes2::Display::instance(), LEVEL_ALL );
+        }
+
+        if ( hideInterface && conf.ShowControlPanel() ) {
+            _controlPanel._redraw();
+        }
+    }
 
     if ( ( hideInterface && conf.ShowRadar() ) || ( combinedRedraw & ( REDRAW_RADAR_CURSOR | REDRAW_RADAR ) ) ) {
         // Redraw radar map only if `REDRAW_RADAR` is set.
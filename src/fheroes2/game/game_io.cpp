@@ -24,11 +24,19 @@
 #include "game_io.h"
 
 #include <algorithm>
+#include <cassert>
 #include <cctype>
+#include <condition_variable>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <ctime>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <ostream>
 #include <utility>
+#include <vector>
 
 #include "campaign_savedata.h"
 #include "campaign_scenariodata.h"
@@ -42,6 +50,7 @@
 #include "serialize.h"
 #include "settings.h"
 #include "system.h"
+#include "thread.h"
 #include "translations.h"
 #include "ui_dialog.h"
 #include "ui_font.h"
@@ -101,6 +110,349 @@ namespace
     {
         return stream >> hdr.requirements >> hdr.info >> hdr.gameType;
     }
+
+    // The size of a portion of the serialized game data which is zipped and written to the disk at once.
+    const size_t saveDataChunkSize{ 256 * 1024 };
+
+    // The maximum number of portions of the game data waiting for the save writer, not including the portion being zipped.
+    const size_t maxQueuedSaveDataChunkCount{ 2 };
+
+    // The state of a save file which is being written. It is accessed by the main thread only until the first portion of the game data
+    // is passed to the save writer, after that it is accessed by the save writer only until the writing of the file is completed.
+    struct SaveFileState final
+    {
+        SaveFileState( std::string path, const Compression::StreamFormat format )
+            : filePath( std::move( path ) )
+            , zipper( format )
+        {
+            // Do nothing.
+        }
+
+        std::string filePath;
+        StreamFile fileStream;
+
+        Compression::StreamZipper zipper;
+        std::vector<uint8_t> zippedData;
+
+        size_t zipHeaderPosition{ 0 };
+        uint64_t rawDataSize{ 0 };
+        uint64_t zippedDataSize{ 0 };
+
+        bool isValid{ true };
+    };
+
+    struct SaveTask final
+    {
+        std::shared_ptr<SaveFileState> saveFile;
+        std::vector<uint8_t> data;
+        bool isLast{ false };
+        bool isCancelled{ false };
+    };
+
+    void discardSaveFile( SaveFileState & saveFile )
+    {
+        saveFile.isValid = false;
+        saveFile.fileStream.close();
+
+        if ( !System::Unlink( saveFile.filePath ) ) {
+            ERROR_LOG( "Unable to remove the incomplete save file " << saveFile.filePath )
+        }
+    }
+
+    void processSaveTask( SaveTask & task )
+    {
+        assert( task.saveFile );
+
+        SaveFileState & saveFile = *task.saveFile;
+        if ( !saveFile.isValid ) {
+            // The save file has been already discarded.
+            return;
+        }
+
+        if ( task.isCancelled ) {
+            discardSaveFile( saveFile );
+            return;
+        }
+
+        saveFile.zippedData.clear();
+
+        if ( !saveFile.zipper.zip( task.data.data(), task.data.size(), task.isLast, saveFile.zippedData ) ) {
+            ERROR_LOG( "Error zipping the game data for the file " << saveFile.filePath )
+            discardSaveFile( saveFile );
+            return;
+        }
+
+        saveFile.rawDataSize += task.data.size();
+        saveFile.zippedDataSize += saveFile.zippedData.size();
+
+        if ( saveFile.rawDataSize > UINT32_MAX || saveFile.zippedDataSize > UINT32_MAX ) {
+            ERROR_LOG( "The game data is too large to be written to the file " << saveFile.filePath )
+            discardSaveFile( saveFile );
+            return;
+        }
+
+        saveFile.fileStream.putRaw( saveFile.zippedData.data(), saveFile.zippedData.size() );
+
+        if ( task.isLast ) {
+            // The final sizes of the data are known only now, so the placeholder of the zip header should be overwritten.
+            saveFile.fileStream.seek( saveFile.zipHeaderPosition );
+            Compression::writeZipStreamHeader( saveFile.fileStream, static_cast<uint32_t>( saveFile.rawDataSize ),
+                                               static_cast<uint32_t>( saveFile.zippedDataSize ), saveFile.zipper.format() );
+        }
+
+        if ( saveFile.fileStream.fail() ) {
+            ERROR_LOG( "Error writing the file " << saveFile.filePath )
+            discardSaveFile( saveFile );
+            return;
+        }
+
+        if ( task.isLast ) {
+            saveFile.fileStream.close();
+        }
+    }
+
+    // Zips the serialized game data and writes it to save files in the background.
+    class AsyncSaveWriter final : public MultiThreading::AsyncManager
+    {
+    public:
+        AsyncSaveWriter() = default;
+        AsyncSaveWriter( const AsyncSaveWriter & ) = delete;
+
+        ~AsyncSaveWriter() override = default;
+
+        AsyncSaveWriter & operator=( const AsyncSaveWriter & ) = delete;
+
+        void setEnabled( const bool enable )
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            _isEnabled = enable;
+        }
+
+        bool isEnabled()
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            return _isEnabled;
+        }
+
+        void pushTask( SaveTask && task )
+        {
+            {
+                std::unique_lock<std::mutex> lock( _mutex );
+
+                if ( _isEnabled ) {
+                    // The serializer waits for the writer to keep only a few portions of the game data in memory.
+                    _queueNotification.wait( lock, [this] { return _tasks.size() < maxQueuedSaveDataChunkCount; } );
+
+                    _tasks.push_back( std::move( task ) );
+                    ++_pendingTaskCount;
+
+                    notifyWorker();
+
+                    return;
+                }
+            }
+
+            // The background writing is not available, the task should be completed right away.
+            processSaveTask( task );
+        }
+
+        // Waits until all the save files passed to the writer are completely written.
+        void waitForCompletion()
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+
+            _completionNotification.wait( lock, [this] { return _pendingTaskCount == 0; } );
+        }
+
+    private:
+        std::deque<SaveTask> _tasks;
+        SaveTask _currentTask;
+
+        std::condition_variable _queueNotification;
+
+        size_t _pendingTaskCount{ 0 };
+        std::condition_variable _completionNotification;
+
+        bool _isEnabled{ false };
+
+        bool prepareTask() override
+        {
+            if ( _currentTask.saveFile ) {
+                // The previous task has been executed.
+                _currentTask = {};
+
+                assert( _pendingTaskCount > 0 );
+                --_pendingTaskCount;
+
+                if ( _pendingTaskCount == 0 ) {
+                    _completionNotification.notify_all();
+                }
+            }
+
+            if ( _tasks.empty() ) {
+                return false;
+            }
+
+            _currentTask = std::move( _tasks.front() );
+            _tasks.pop_front();
+
+            _queueNotification.notify_one();
+
+            return true;
+        }
+
+        void executeTask() override
+        {
+            if ( !_currentTask.saveFile ) {
+                // There is no task to execute.
+                return;
+            }
+
+            processSaveTask( _currentTask );
+        }
+    };
+
+    AsyncSaveWriter asyncSaveWriter;
+
+    // Output stream which passes the serialized game data to the save writer by portions of a fixed size. The current portion is exposed
+    // as a put area so most of the values are written to it without virtual calls.
+    class SaveDataStream final : public OStreamBase
+    {
+    public:
+        explicit SaveDataStream( std::shared_ptr<SaveFileState> saveFile )
+            : _saveFile( std::move( saveFile ) )
+        {
+            _putCursor = &_bufferPos;
+
+            resetBuffer();
+        }
+
+        SaveDataStream( const SaveDataStream & ) = delete;
+
+        ~SaveDataStream() override
+        {
+            if ( _saveFile ) {
+                // The serialization has not been completed.
+                pushTask( true, true );
+            }
+        }
+
+        SaveDataStream & operator=( const SaveDataStream & ) = delete;
+
+        void putBE16( uint16_t v ) override
+        {
+            put8( v >> 8 );
+            put8( v & 0xFF );
+        }
+
+        void putLE16( uint16_t v ) override
+        {
+            put8( v & 0xFF );
+            put8( v >> 8 );
+        }
+
+        void putBE32( uint32_t v ) override
+        {
+            put8( v >> 24 );
+            put8( ( v >> 16 ) & 0xFF );
+            put8( ( v >> 8 ) & 0xFF );
+            put8( v & 0xFF );
+        }
+
+        void putLE32( uint32_t v ) override
+        {
+            put8( v & 0xFF );
+            put8( ( v >> 8 ) & 0xFF );
+            put8( ( v >> 16 ) & 0xFF );
+            put8( v >> 24 );
+        }
+
+        void putRaw( const void * ptr, size_t size ) override
+        {
+            const uint8_t * data = static_cast<const uint8_t *>( ptr );
+
+            while ( size > 0 ) {
+                if ( freeSpace() == 0 ) {
+                    pushTask( false, false );
+                }
+
+                const size_t portionSize = std::min( size, freeSpace() );
+
+                std::memcpy( _bufferPos, data, portionSize );
+                _bufferPos += portionSize;
+
+                data += portionSize;
+                size -= portionSize;
+            }
+        }
+
+        // Passes the last portion of the data to the save writer. No data can be written to this stream after that.
+        void finish()
+        {
+            assert( _saveFile );
+
+            pushTask( true, fail() );
+        }
+
+    private:
+        std::shared_ptr<SaveFileState> _saveFile;
+
+        // The current portion of the data. Its size is always equal to saveDataChunkSize while the data is being written.
+        std::vector<uint8_t> _buffer;
+        uint8_t * _bufferPos{ nullptr };
+
+        void put8( const uint8_t v ) override
+        {
+            assert( _saveFile );
+
+            if ( freeSpace() == 0 ) {
+                pushTask( false, false );
+            }
+
+            *_bufferPos = v;
+            ++_bufferPos;
+        }
+
+        size_t freeSpace() const
+        {
+            return static_cast<size_t>( _putEnd - _bufferPos );
+        }
+
+        void resetBuffer()
+        {
+            _buffer.resize( saveDataChunkSize );
+
+            _bufferPos = _buffer.data();
+            _putEnd = _buffer.data() + _buffer.size();
+        }
+
+        void pushTask( const bool isLast, const bool isCancelled )
+        {
+            assert( _saveFile );
+
+            _buffer.resize( static_cast<size_t>( _bufferPos - _buffer.data() ) );
+
+            SaveTask task;
+            task.saveFile = isLast ? std::move( _saveFile ) : _saveFile;
+            task.data = std::move( _buffer );
+            task.isLast = isLast;
+            task.isCancelled = isCancelled;
+
+            asyncSaveWriter.pushTask( std::move( task ) );
+
+            _buffer = {};
+
+            if ( isLast ) {
+                _bufferPos = nullptr;
+                _putEnd = nullptr;
+            }
+            else {
+                resetBuffer();
+            }
+        }
+    };
 }
 
 bool Game::AutoSave()
@@ -117,7 +469,18 @@ bool Game::Save( const std::string & filePath, const bool autoSave /* = false */
 {
     DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
 
-    StreamFile fileStream;
+    // The same file could be still being written in the background.
+    asyncSaveWriter.waitForCompletion();
+
+    const Settings & conf = Settings::Get();
+
+    // Starting from FORMAT_VERSION_PRE1_1190_RELEASE the game data can be zipped by the fast LZ codec instead of zlib. Save files are read
+    // regardless of this setting since the format of the zipped data is stored in its header.
+    const Compression::StreamFormat saveDataFormat = conf.isFastSaveCompressionEnabled() ? Compression::StreamFormat::FAST_LZ : Compression::StreamFormat::ZLIB;
+
+    auto saveFile = std::make_shared<SaveFileState>( filePath, saveDataFormat );
+
+    StreamFile & fileStream = saveFile->fileStream;
     fileStream.setBigendian( true );
 
     if ( !fileStream.open( filePath, "wb" ) ) {
@@ -130,15 +493,25 @@ bool Game::Save( const std::string & filePath, const bool autoSave /* = false */
     const uint16_t saveFileVersion = CURRENT_FORMAT_VERSION;
 
     // Header
-    const Settings & conf = Settings::Get();
-
     fileStream << saveFileMagicNumber << std::to_string( saveFileVersion ) << saveFileVersion
                << HeaderSAV( conf.getCurrentMapInfo(), conf.GameType(), world.GetDay(), world.GetWeek(), world.GetMonth() );
+
+    // The sizes of the zipped data are not known yet, so a placeholder is written instead of the zip header. It is overwritten
+    // by the save writer once all the data is zipped.
+    saveFile->zipHeaderPosition = fileStream.tell();
+    Compression::writeZipStreamHeader( fileStream, 0, 0, saveDataFormat );
+
     if ( fileStream.fail() ) {
+        discardSaveFile( *saveFile );
         return false;
     }
 
-    RWStreamBuf dataStream;
+    // The state is checked after writing the file to find out whether it has been written successfully.
+    const std::shared_ptr<const SaveFileState> saveFileState = saveFile;
+
+    // The game data is zipped and written to the file by portions while it is still being serialized. If the background writing
+    // is enabled then autosaves are completed without waiting for the file to be written and their write errors are only logged.
+    SaveDataStream dataStream( std::move( saveFile ) );
     dataStream.setBigendian( true );
 
     dataStream << World::Get() << conf << GameOver::Result::Get();
@@ -152,14 +525,25 @@ bool Game::Save( const std::string & filePath, const bool autoSave /* = false */
 
     // End-of-data marker
     dataStream << saveFileMagicNumber;
-    if ( dataStream.fail() || !Compression::zipStreamBuf( dataStream, fileStream ) ) {
+    if ( dataStream.fail() ) {
         return false;
     }
 
-    if ( !autoSave ) {
-        Game::SetLastSaveName( filePath );
+    dataStream.finish();
+
+    if ( autoSave ) {
+        return true;
+    }
+
+    // The player must be notified if the game has not been actually saved, so wait for the file to be written.
+    asyncSaveWriter.waitForCompletion();
+
+    if ( !saveFileState->isValid ) {
+        return false;
     }
 
+    Game::SetLastSaveName( filePath );
+
     return true;
 }
 
@@ -167,6 +551,8 @@ fheroes2::GameMode Game::Load( const std::string & filePath )
 {
     DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
 
+    asyncSaveWriter.waitForCompletion();
+
     const auto showGenericErrorMessage = []() { fheroes2::showStandardTextMessage( _( "Error" ), _( "The save file is corrupted." ), Dialog::OK ); };
 
     StreamFile fileStream;
@@ -308,6 +694,8 @@ bool Game::LoadSAV2FileInfo( std::string filePath, Maps::FileInfo & fileInfo )
 {
     DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
 
+    asyncSaveWriter.waitForCompletion();
+
     StreamFile fs;
     fs.setBigendian( true );
 
@@ -354,6 +742,19 @@ bool Game::LoadSAV2FileInfo( std::string filePath, Maps::FileInfo & fileInfo )
     return true;
 }
 
+Game::AsyncSaveInitializer::AsyncSaveInitializer()
+{
+    asyncSaveWriter.createWorker();
+    asyncSaveWriter.setEnabled( true );
+}
+
+Game::AsyncSaveInitializer::~AsyncSaveInitializer()
+{
+    asyncSaveWriter.setEnabled( false );
+    asyncSaveWriter.waitForCompletion();
+    asyncSaveWriter.stopWorker();
+}
+
 void Game::SetVersionOfCurrentSaveFile( const uint16_t version )
 {
     versionOfCurrentSaveFile = version;
@@ -26,6 +26,7 @@
 #include <cstdint>
 #include <string>
 
+#include "component_base.h"
 #include "game_mode.h"
 
 namespace Maps
@@ -49,6 +50,8 @@ namespace Game
     bool AutoSave();
     bool QuickSave();
 
+    // Returns false if the game has not been saved. Autosaves can be still being written to the disk after this function returns,
+    // in this case write errors are only logged.
     bool Save( const std::string & filePath, const bool autoSave = false );
 
     // Returns GameMode::CANCEL in case of failure.
@@ -57,4 +60,17 @@ namespace Game
     bool LoadSAV2FileInfo( std::string filePath, Maps::FileInfo & fileInfo );
 
     bool SaveCompletedCampaignScenario();
+
+    // Saved games are zipped and written to the disk in the background while an instance of this class exists. Otherwise they are written
+    // right away. The destructor waits until all the saved games are completely written.
+    class AsyncSaveInitializer final : public ComponentBase
+    {
+    public:
+        AsyncSaveInitializer();
+        AsyncSaveInitializer( const AsyncSaveInitializer & ) = delete;
+
+        ~AsyncSaveInitializer() override;
+
+        AsyncSaveInitializer & operator=( const AsyncSaveInitializer & ) = delete;
+    };
 }
@@ -0,0 +1,241 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "game_render_benchmark.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <utility>
+
+#include "color.h"
+#include "game_assets.h"
+#include "game_interface.h"
+#include "interface_base.h"
+#include "interface_gamearea.h"
+#include "interface_radar.h"
+#include "interface_status.h"
+#include "logging.h"
+#include "maps_fileinfo.h"
+#include "math_base.h"
+#include "players.h"
+#include "screen.h"
+#include "settings.h"
+#include "timing.h"
+#include "ui_constants.h"
+#include "ui_language.h"
+#include "world.h"
+
+namespace
+{
+    // The camera is moved by this number of pixels every frame which is close to the regular scrolling speed.
+    constexpr int32_t panStepPx{ 16 };
+
+    enum class BenchmarkStage : uint8_t
+    {
+        GAME_AREA,
+        RADAR,
+        STATUS,
+        RENDER,
+
+        // The number of stages, not a stage itself.
+        COUNT
+    };
+
+    const char * getStageName( const BenchmarkStage stage )
+    {
+        switch ( stage ) {
+        case BenchmarkStage::GAME_AREA:
+            return "game area";
+        case BenchmarkStage::RADAR:
+            return "radar";
+        case BenchmarkStage::STATUS:
+            return "status";
+        case BenchmarkStage::RENDER:
+            return "render";
+        default:
+            // Did you add a new stage? Add the logic above!
+            assert( 0 );
+            break;
+        }
+
+        return "unknown";
+    }
+
+    struct StageTiming
+    {
+        double totalS{ 0 };
+        double maxS{ 0 };
+
+        void add( const double timeS )
+        {
+            totalS += timeS;
+            maxS = std::max( maxS, timeS );
+        }
+    };
+
+    // The camera goes round a rectangle around the center of the map which covers a half of the map in each direction,
+    // so every frame contains a different part of the map and the camera never stops at the map edges.
+    std::array<fheroes2::Point, 4> getPanCorners()
+    {
+        const int32_t mapWidthPx = world.w() * fheroes2::tileWidthPx;
+        const int32_t mapHeightPx = world.h() * fheroes2::tileWidthPx;
+
+        const int32_t left = mapWidthPx / 4;
+        const int32_t right = mapWidthPx - left;
+        const int32_t top = mapHeightPx / 4;
+        const int32_t bottom = mapHeightPx - top;
+
+        return { fheroes2::Point{ left, top }, fheroes2::Point{ right, top }, fheroes2::Point{ right, bottom }, fheroes2::Point{ left, bottom } };
+    }
+
+    fheroes2::Point moveTowards( const fheroes2::Point & from, const fheroes2::Point & to )
+    {
+        return { from.x + std::clamp( to.x - from.x, -panStepPx, panStepPx ), from.y + std::clamp( to.y - from.y, -panStepPx, panStepPx ) };
+    }
+
+    bool prepareMap( const std::string & mapFilePath )
+    {
+        Maps::FileInfo mapInfo;
+        if ( !mapInfo.readResurrectionMap( mapFilePath, false, fheroes2::getCurrentLanguage() ) ) {
+            ERROR_LOG( "Failed to read the map file " << mapFilePath << " for render benchmark." )
+            return false;
+        }
+
+        Settings & conf = Settings::Get();
+        conf.setCurrentMapInfo( std::move( mapInfo ) );
+
+        Players & players = conf.GetPlayers();
+        players.Init( conf.getCurrentMapInfo() );
+        players.SetStartGame();
+
+        if ( !world.loadResurrectionMap( conf.getCurrentMapInfo().filename ) ) {
+            ERROR_LOG( "Failed to load the map " << mapFilePath << " for render benchmark." )
+            return false;
+        }
+
+        const PlayerColorsVector humanColors( Players::HumanColors() );
+        if ( humanColors.empty() ) {
+            ERROR_LOG( "The map " << mapFilePath << " has no human players." )
+            return false;
+        }
+
+        // The map is shown as it is seen by the first human player at the beginning of the game.
+        conf.SetCurrentColor( humanColors.front() );
+        world.ClearFog( humanColors.front() );
+
+        return true;
+    }
+}
+
+namespace fheroes2
+{
+    bool runRenderBenchmark( const RenderBenchmarkOptions & options, std::ostream & output )
+    {
+        assert( options.frameCount > 0 );
+
+        if ( !prepareMap( options.mapFilePath ) ) {
+            return false;
+        }
+
+        Display & display = Display::instance();
+        display.enableOffscreenRendering( options.frameDumpDirectory );
+        display.setResolution( { options.width, options.height } );
+
+        if ( display.empty() ) {
+            ERROR_LOG( "Failed to set " << options.width << "x" << options.height << " resolution for render benchmark." )
+            return false;
+        }
+
+        Interface::AdventureMap & adventureMap = Interface::AdventureMap::Get();
+        adventureMap.reset();
+
+        Interface::GameArea & gameArea = adventureMap.getGameArea();
+        Interface::Radar & radar = adventureMap.getRadar();
+
+        radar.Build();
+        radar.SetHide( false );
+        adventureMap.getStatusPanel().Reset();
+
+        Interface::GameArea::updateMapFogDirections();
+
+        const std::array<Point, 4> corners = getPanCorners();
+        size_t nextCornerId = 0;
+
+        Point center = corners.back();
+        gameArea.SetCenterInPixels( center );
+
+        // The first frame contains the whole interface and is not measured.
+        adventureMap.redraw( Interface::REDRAW_ALL );
+        display.render();
+
+        std::array<StageTiming, static_cast<size_t>( BenchmarkStage::COUNT )> timings;
+
+        const auto measure = [&timings]( const BenchmarkStage stage, const auto & action ) {
+            const Time timer;
+            action();
+            timings[static_cast<size_t>( stage )].add( timer.getS() );
+        };
+
+        for ( int32_t frameId = 0; frameId < options.frameCount; ++frameId ) {
+            if ( center == corners[nextCornerId] ) {
+                nextCornerId = ( nextCornerId + 1 ) % corners.size();
+            }
+
+            center = moveTowards( center, corners[nextCornerId] );
+            gameArea.SetCenterInPixels( center );
+
+            // Keep the same memory limit for images as the Adventure Map does.
+            Assets::trimImageCache( Settings::Get().imageCacheLimit() );
+
+            measure( BenchmarkStage::GAME_AREA, [&adventureMap]() { adventureMap.redraw( Interface::REDRAW_GAMEAREA ); } );
+            measure( BenchmarkStage::RADAR, [&adventureMap]() { adventureMap.redraw( Interface::REDRAW_RADAR_CURSOR ); } );
+            measure( BenchmarkStage::STATUS, [&adventureMap]() { adventureMap.redraw( Interface::REDRAW_STATUS ); } );
+            measure( BenchmarkStage::RENDER, [&display]() { display.render(); } );
+        }
+
+        output << "# map: " << options.mapFilePath << '\n';
+        output << "# resolution: " << display.width() << 'x' << display.height() << '\n';
+        output << "stage,frames,total ms,average ms,max ms\n";
+
+        double frameTotalS = 0;
+
+        for ( size_t i = 0; i < timings.size(); ++i ) {
+            const StageTiming & timing = timings[i];
+            frameTotalS += timing.totalS;
+
+            output << getStageName( static_cast<BenchmarkStage>( i ) ) << ',' << options.frameCount << ',' << timing.totalS * 1000 << ','
+                   << timing.totalS * 1000 / options.frameCount << ',' << timing.maxS * 1000 << '\n';
+        }
+
+        output << "# frame time: " << frameTotalS * 1000 / options.frameCount << " ms\n";
+
+        const Assets::ImageCacheStatistics & cacheStatistics = Assets::getImageCacheStatistics();
+        output << "# image cache: " << cacheStatistics.hits << " hits, " << cacheStatistics.misses << " misses, " << cacheStatistics.evictions << " evictions, "
+               << cacheStatistics.memoryUsage << " bytes of evictable images\n";
+
+        output.flush();
+
+        return true;
+    }
+}
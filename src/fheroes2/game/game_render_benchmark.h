@@ -0,0 +1,48 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace fheroes2
+{
+    struct RenderBenchmarkOptions final
+    {
+        static constexpr int32_t frameLimit{ 100000 };
+
+        std::string mapFilePath;
+
+        // Rendered frames are saved as images into this directory if it is not empty.
+        std::string frameDumpDirectory;
+
+        int32_t width{ 640 };
+        int32_t height{ 480 };
+
+        int32_t frameCount{ 1000 };
+    };
+
+    // Renders the Adventure Map interface of the given Resurrection map without any window while the camera pans over the map
+    // by a fixed script. The time spent on the game area, radar, status panel and on the frame rendering itself is measured
+    // for every frame and written to the output as CSV. Returns false if the map cannot be loaded or the display cannot be set up.
+    bool runRenderBenchmark( const RenderBenchmarkOptions & options, std::ostream & output );
+}
@@ -1102,6 +1102,10 @@ fheroes2::GameMode Interface::AdventureMap::HumanTurn( const bool isLoadedFromSa
     };
 
     while ( res == fheroes2::GameMode::CANCEL ) {
+        // Adventure Map interface elements request their images on every redraw and keep no references to them between iterations of this loop,
+        // so it is the right place to free images that have not been used recently.
+        Assets::trimImageCache( conf.imageCacheLimit() );
+
         if ( !le.HandleEvents( Game::isDelayNeeded( delayTypes ), true ) ) {
             if ( Game::processExitEvent() == fheroes2::GameMode::QUIT_GAME ) {
                 res = fheroes2::GameMode::QUIT_GAME;
@@ -1419,7 +1423,7 @@ fheroes2::GameMode Interface::AdventureMap::HumanTurn( const bool isLoadedFromSa
                     const int32_t heroMovementSkipValue = Game::HumanHeroAnimSpeedMultiplier();
 
                     _gameArea.ShiftCenter( { heroAnimationOffset.x * heroMovementSkipValue, heroAnimationOffset.y * heroMovementSkipValue } );
-                    _gameArea.SetRedraw();
+                    setRedraw( REDRAW_GAMEAREA_CHANGES );
 
                     if ( heroAnimationOffset != fheroes2::Point() ) {
                         Game::EnvironmentSoundMixer();
@@ -1480,7 +1484,7 @@ fheroes2::GameMode Interface::AdventureMap::HumanTurn( const bool isLoadedFromSa
                                 }
                             }
 
-                            _gameArea.SetRedraw();
+                            setRedraw( REDRAW_GAMEAREA_CHANGES );
                         }
 
                         // Update the hero's move status.
@@ -1568,16 +1572,24 @@ fheroes2::GameMode Interface::AdventureMap::HumanTurn( const bool isLoadedFromSa
         if ( Game::validateAnimationDelay( Game::DelayType::MAPS_DELAY ) ) {
             Game::updateAdventureMapAnimationIndex();
 
-            _gameArea.SetRedraw();
+            setRedraw( REDRAW_GAMEAREA_CHANGES );
         }
 
         if ( needRedraw() ) {
+            // If only the changed parts of the game area are going to be updated there is no need to render the whole display image.
+            const bool isPartialRedrawOnly = ( getRedrawMask() == REDRAW_GAMEAREA_CHANGES );
+
             redraw( 0 );
 
             // If this assertion blows up it means that we are holding a RedrawLocker lock for rendering which should not happen.
             assert( getRedrawMask() == 0 );
 
-            validateFadeInAndRender();
+            if ( isPartialRedrawOnly ) {
+                validateFadeInAndRender( _gameArea.getLastUpdatedArea() );
+            }
+            else {
+                validateFadeInAndRender();
+            }
         }
     }
 
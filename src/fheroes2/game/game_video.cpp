@@ -60,6 +60,74 @@ namespace
         }
     }
 
+    // Passes the audio of a video to the mixer by portions of frames while the video is being played, so the whole audio track
+    // does not have to be decoded before the playback.
+    class VideoAudioStreamer final
+    {
+    public:
+        // Returns false if the streaming playback is not available.
+        bool start( SMKVideoSequence & video )
+        {
+            stop();
+
+            if ( !video.resetAudio() ) {
+                return false;
+            }
+
+            const uint32_t durationMs = static_cast<uint32_t>( video.microsecondsPerFrame() * static_cast<double>( video.frameCount() ) / 1000 );
+
+            for ( const SMKVideoSequence::AudioTrackInfo & track : video.getAudioTracks() ) {
+                if ( !_streams.emplace_back().start( track.sampleRate, track.bitsPerSample, track.channelCount, durationMs ) ) {
+                    stop();
+                    return false;
+                }
+            }
+
+            _video = &video;
+            _leadFrameCount = static_cast<unsigned long>( std::ceil( audioLeadTimeUs / video.microsecondsPerFrame() ) );
+
+            update();
+
+            return true;
+        }
+
+        // Passes the audio of frames which are going to be played soon to the mixer.
+        void update()
+        {
+            if ( _video == nullptr ) {
+                return;
+            }
+
+            // The audio is passed ahead of the video frames to avoid gaps in the playback.
+            while ( _video->getCurrentAudioFrameId() <= _video->getCurrentFrameId() + _leadFrameCount && _video->getNextAudioFrame( _audioData ) ) {
+                assert( _audioData.size() == _streams.size() );
+
+                for ( size_t i = 0; i < _streams.size(); ++i ) {
+                    _streams[i].put( _audioData[i].data(), _audioData[i].size() );
+                }
+            }
+        }
+
+        void stop()
+        {
+            for ( Mixer::AudioStream & stream : _streams ) {
+                stream.stop();
+            }
+
+            _streams.clear();
+            _video = nullptr;
+        }
+
+    private:
+        static constexpr double audioLeadTimeUs{ 500000 };
+
+        std::vector<Mixer::AudioStream> _streams;
+        std::vector<std::vector<uint8_t>> _audioData;
+
+        SMKVideoSequence * _video{ nullptr };
+        unsigned long _leadFrameCount{ 0 };
+    };
+
     // Internal video state structure during playback.
     struct VideoState final
     {
@@ -67,7 +135,16 @@ namespace
         fheroes2::Rect area;
         int32_t delayBetweenFramesInMs{ 0 };
         int32_t nextFrameInMs{ 0 };
+        VideoAudioStreamer audio;
     };
+
+    void startAudio( VideoState & state, SMKVideoSequence & video )
+    {
+        if ( !state.audio.start( video ) ) {
+            // The streaming playback is not available, so the whole audio track has to be decoded in advance.
+            playAudio( video.getAudioChannels() );
+        }
+    }
 }
 
 namespace Video
@@ -149,7 +226,7 @@ namespace Video
             minDelayInMs = std::min( minDelayInMs, delay );
 
             const fheroes2::Rect frameRoi{ info.offset.x, info.offset.y, video->width(), video->height() };
-            const VideoState state{ info.control, frameRoi, delay, delay };
+            VideoState state{ info.control, frameRoi, delay, delay, {} };
 
             if ( videoRoi == fheroes2::Rect{} ) {
                 videoRoi = frameRoi;
@@ -158,7 +235,7 @@ namespace Video
                 videoRoi = fheroes2::getBoundaryRect( videoRoi, frameRoi );
             }
 
-            sequences.emplace_back( state, std::move( video ) );
+            sequences.emplace_back( std::move( state ), std::move( video ) );
         }
 
         // Center the video in the middle of the application.
@@ -214,9 +291,9 @@ namespace Video
 
         // Play audio just before rendering the frame. This is important to minimize synchronization issues between audio and video.
         if ( Audio::isValid() ) {
-            for ( const auto & [state, video] : sequences ) {
+            for ( auto & [state, video] : sequences ) {
                 if ( state.control & VideoControl::PLAY_AUDIO ) {
-                    playAudio( video->getAudioChannels() );
+                    startAudio( state, *video );
                 }
             }
         }
@@ -242,7 +319,7 @@ namespace Video
                                 video->resetFrame();
 
                                 if ( Audio::isValid() && ( state.control & VideoControl::PLAY_AUDIO ) ) {
-                                    playAudio( video->getAudioChannels() );
+                                    startAudio( state, *video );
                                 }
                             }
                             else {
@@ -262,6 +339,8 @@ namespace Video
                                 video->skipFrame();
                             }
                             state.nextFrameInMs = state.delayBetweenFramesInMs;
+
+                            state.audio.update();
                         }
                         else {
                             if ( state.control & VideoControl::PLAY_VIDEO ) {
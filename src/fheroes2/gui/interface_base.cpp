@@ -48,4 +48,16 @@ namespace Interface
             fheroes2::Display::instance().render();
         }
     }
+
+    void Interface::BaseInterface::validateFadeInAndRender( const fheroes2::Rect & roi )
+    {
+        if ( Game::validateDisplayFadeIn() ) {
+            fheroes2::fadeInDisplay();
+
+            setRedraw( REDRAW_GAMEAREA );
+        }
+        else if ( roi.width > 0 && roi.height > 0 ) {
+            fheroes2::Display::instance().render( roi );
+        }
+    }
 }
@@ -55,7 +55,11 @@ namespace Interface
         REDRAW_ALL = 0x1FF,
 
         // This option is only for the Editor.
-        REDRAW_PASSABILITIES = 0x200
+        REDRAW_PASSABILITIES = 0x200,
+
+        // This option is only for the game (Adventure Map) interface.
+        // To render only the parts of the game area changed since the previous frame. It is ignored if REDRAW_GAMEAREA is set.
+        REDRAW_GAMEAREA_CHANGES = 0x400
     };
 
     class BaseInterface
@@ -149,6 +153,9 @@ namespace Interface
         // If display fade-in state is set reset it to false and fade-in the full display image. Otherwise render full display image without fade-in.
         void validateFadeInAndRender();
 
+        // The same as above but renders only the given area of the display image if there is no fade-in.
+        void validateFadeInAndRender( const fheroes2::Rect & roi );
+
         GameArea _gameArea;
         Radar _radar;
 
@@ -47,10 +47,12 @@
 #include "interface_cpanel.h"
 #include "localevent.h"
 #include "logging.h"
+#include "map_object_info.h"
 #include "maps.h"
 #include "maps_tiles.h"
 #include "maps_tiles_helper.h"
 #include "maps_tiles_render.h"
+#include "math_tools.h"
 #include "pal.h"
 #include "players.h"
 #include "route.h"
@@ -323,6 +325,108 @@ namespace
 
         return false;
     }
+
+    bool isObjectPartAnimated( const Maps::ObjectPart & part )
+    {
+        if ( part.icnType == MP2::OBJ_ICN_TYPE_UNKNOWN ) {
+            return false;
+        }
+
+        const auto * objectInfo = Maps::getObjectPartByIcn( part.icnType, part.icnIndex );
+        return objectInfo != nullptr && objectInfo->animationFrames > 0;
+    }
+
+    // Returns true if the look of any object on the tile depends on the adventure map animation frame.
+    bool isTileAnimated( const Maps::Tile & tile, const bool renderFog )
+    {
+        switch ( tile.getMainObjectType() ) {
+        case MP2::OBJ_HERO:
+        case MP2::OBJ_MONSTER:
+        case MP2::OBJ_ABANDONED_MINE:
+        case MP2::OBJ_MINE:
+            // Heroes have animated flags, monsters and mine guardians have their own animation and ghosts fly over the haunted mines.
+            // All these objects can be rendered even if their tile is fully covered with the fog.
+            return true;
+        default:
+            break;
+        }
+
+        if ( renderFog && tile.getFogDirection() == DIRECTION_ALL ) {
+            return false;
+        }
+
+        if ( isObjectPartAnimated( tile.getMainObjectPart() ) ) {
+            return true;
+        }
+
+        const auto & groundParts = tile.getGroundObjectParts();
+        if ( std::any_of( groundParts.begin(), groundParts.end(), isObjectPartAnimated ) ) {
+            return true;
+        }
+
+        const auto & topParts = tile.getTopObjectParts();
+        return std::any_of( topParts.begin(), topParts.end(), isObjectPartAnimated );
+    }
+
+    // Returns the hash of all the tile properties that affect how the tile and its objects are rendered, except the terrain which
+    // does not change during the game and the animation frame.
+    uint64_t getTileRenderState( const Maps::Tile & tile, const bool renderFog )
+    {
+        uint64_t state = 14695981039346656037ULL;
+
+        const auto addValue = [&state]( const uint32_t value ) { state = ( state ^ value ) * 1099511628211ULL; };
+        const auto addObjectPart = [&addValue]( const Maps::ObjectPart & part ) {
+            addValue( part._uid );
+            addValue( static_cast<uint32_t>( part.layerType ) );
+            addValue( static_cast<uint32_t>( part.icnType ) );
+            addValue( part.icnIndex );
+        };
+
+        addValue( renderFog ? tile.getFogDirection() : 0 );
+        addValue( static_cast<uint32_t>( tile.getMainObjectType() ) );
+
+        addObjectPart( tile.getMainObjectPart() );
+
+        for ( const auto & part : tile.getGroundObjectParts() ) {
+            addObjectPart( part );
+        }
+
+        for ( const auto & part : tile.getTopObjectParts() ) {
+            addObjectPart( part );
+        }
+
+        for ( const uint32_t value : tile.metadata() ) {
+            addValue( value );
+        }
+
+        const Heroes * hero = tile.getHero();
+        if ( hero == nullptr ) {
+            return state;
+        }
+
+        const fheroes2::Point heroOffset = hero->getCurrentPixelOffset();
+
+        addValue( static_cast<uint32_t>( hero->GetID() ) );
+        addValue( static_cast<uint32_t>( hero->GetSpriteIndex() ) );
+        addValue( static_cast<uint32_t>( heroOffset.x ) );
+        addValue( static_cast<uint32_t>( heroOffset.y ) );
+        addValue( static_cast<uint32_t>( hero->GetDirection() ) );
+        addValue( static_cast<uint32_t>( hero->GetColor() ) );
+        addValue( hero->isShipMaster() ? 1 : 0 );
+        addValue( hero->getAlphaValue() );
+
+        // A moving hero is rendered depending on the fog on the tile to which he is moving.
+        if ( hero->isMoveEnabled() ) {
+            addValue( renderFog ? world.getTile( hero->GetPath().GetFrontIndex() ).getFogDirection() + 1U : 1U );
+        }
+
+        return state;
+    }
+
+    int32_t getTileCoordinate( const int32_t pixel )
+    {
+        return ( pixel >= 0 ) ? pixel / fheroes2::tileWidthPx : ( pixel - fheroes2::tileWidthPx + 1 ) / fheroes2::tileWidthPx;
+    }
 }
 
 Interface::GameArea::GameArea( BaseInterface & interface )
@@ -345,6 +449,7 @@ void Interface::GameArea::generate( const fheroes2::Size & screenSize, const boo
 void Interface::GameArea::SetAreaPosition( int32_t x, int32_t y, int32_t w, int32_t h )
 {
     _windowROI = { x, y, w, h };
+    _renderROI = _windowROI;
     const fheroes2::Size worldSize( world.w() * fheroes2::tileWidthPx, world.h() * fheroes2::tileWidthPx );
 
     if ( worldSize.width > w ) {
@@ -377,7 +482,7 @@ void Interface::GameArea::BlitOnTile( fheroes2::Image & dst, const fheroes2::Ima
     const fheroes2::Point tileOffset = GetRelativeTilePosition( mp );
 
     const fheroes2::Rect imageRoi{ tileOffset.x + ox, tileOffset.y + oy, src.width(), src.height() };
-    const fheroes2::Rect overlappedRoi = _windowROI ^ imageRoi;
+    const fheroes2::Rect overlappedRoi = _renderROI ^ imageRoi;
 
     fheroes2::AlphaBlit( src, overlappedRoi.x - imageRoi.x, overlappedRoi.y - imageRoi.y, dst, overlappedRoi.x, overlappedRoi.y, overlappedRoi.width,
                          overlappedRoi.height, alpha, flip );
@@ -389,7 +494,7 @@ void Interface::GameArea::BlitOnTile( fheroes2::Image & dst, const fheroes2::Ima
     const fheroes2::Point tileOffset = GetRelativeTilePosition( mp );
 
     const fheroes2::Rect imageRoi{ tileOffset.x + ox, tileOffset.y + oy, srcRoi.width, srcRoi.height };
-    const fheroes2::Rect overlappedRoi = _windowROI ^ imageRoi;
+    const fheroes2::Rect overlappedRoi = _renderROI ^ imageRoi;
 
     fheroes2::AlphaBlit( src, srcRoi.x + overlappedRoi.x - imageRoi.x, srcRoi.y + overlappedRoi.y - imageRoi.y, dst, overlappedRoi.x, overlappedRoi.y,
                          overlappedRoi.width, overlappedRoi.height, alpha, flip );
@@ -400,15 +505,354 @@ void Interface::GameArea::DrawTile( fheroes2::Image & dst, const fheroes2::Image
     const fheroes2::Point tileOffset = GetRelativeTilePosition( mp );
 
     const fheroes2::Rect imageRoi{ tileOffset.x, tileOffset.y, src.width(), src.height() };
-    const fheroes2::Rect overlappedRoi = _windowROI ^ imageRoi;
+    const fheroes2::Rect overlappedRoi = _renderROI ^ imageRoi;
 
     fheroes2::Copy( src, overlappedRoi.x - imageRoi.x, overlappedRoi.y - imageRoi.y, dst, overlappedRoi.x, overlappedRoi.y, overlappedRoi.width, overlappedRoi.height );
 }
 
+void Interface::GameArea::DrawTile( fheroes2::Image & dst, const fheroes2::Image & src, const fheroes2::Rect & srcRoi, const fheroes2::Point & mp ) const
+{
+    const fheroes2::Point tileOffset = GetRelativeTilePosition( mp );
+
+    const fheroes2::Rect imageRoi{ tileOffset.x, tileOffset.y, srcRoi.width, srcRoi.height };
+    const fheroes2::Rect overlappedRoi = _renderROI ^ imageRoi;
+
+    fheroes2::Copy( src, srcRoi.x + overlappedRoi.x - imageRoi.x, srcRoi.y + overlappedRoi.y - imageRoi.y, dst, overlappedRoi.x, overlappedRoi.y, overlappedRoi.width,
+                    overlappedRoi.height );
+}
+
 void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzleDraw ) const
 {
-    const fheroes2::Rect & tileROI = GetVisibleTileROI();
+    std::vector<RouteMark> routeMarks = _getRouteMarks( flag );
+
+    _redrawTiles( dst, GetVisibleTileROI(), flag, isPuzzleDraw, routeMarks );
+
+    updateObjectAnimationInfo();
+
+    if ( isPuzzleDraw ) {
+        return;
+    }
+
+    // Keep the frame to be able to update only its changed parts later.
+    if ( _backBuffer.width() != dst.width() || _backBuffer.height() != dst.height() ) {
+        _backBuffer._disableTransformLayer();
+        _backBuffer.resize( dst.width(), dst.height() );
+    }
+
+    fheroes2::Copy( dst, _windowROI.x, _windowROI.y, _backBuffer, _windowROI.x, _windowROI.y, _windowROI.width, _windowROI.height );
+
+    _updateTileStates( flag, nullptr );
+    _routeMarks = std::move( routeMarks );
+
+    _lastRedrawImage = &dst;
+    _lastRedrawImageSize = { dst.width(), dst.height() };
+    _lastRedrawFlag = flag;
+    _lastRedrawTopLeftTileOffset = _topLeftTileOffset;
+    _lastRedrawWindowROI = _windowROI;
+    _lastUpdatedArea = _windowROI;
+}
+
+void Interface::GameArea::redrawChangedTiles( fheroes2::Image & dst, const int flag ) const
+{
+    // The partial redraw is possible only on top of the previous frame rendered in the same way.
+    // Any object fading animation also changes the whole image so it needs a full redraw.
+    if ( _lastRedrawImage != &dst || _lastRedrawImageSize != fheroes2::Size( dst.width(), dst.height() ) || _lastRedrawFlag != flag
+         || _lastRedrawWindowROI != _windowROI || !_animationInfo.empty() ) {
+        Redraw( dst, flag );
+        return;
+    }
+
+    // Nothing can be reused if the view has been shifted by the size of the Game Area or more.
+    const fheroes2::Point viewShift = _topLeftTileOffset - _lastRedrawTopLeftTileOffset;
+    if ( std::abs( viewShift.x ) >= _windowROI.width || std::abs( viewShift.y ) >= _windowROI.height ) {
+        Redraw( dst, flag );
+        return;
+    }
+
+    const fheroes2::Rect tileROI = GetVisibleTileROI();
+    const int32_t worldWidth = world.w();
+    const int32_t worldHeight = world.h();
+
+#ifdef WITH_DEBUG
+    const bool renderFog = ( ( flag & LEVEL_FOG ) == LEVEL_FOG ) && !IS_DEVEL();
+#else
+    const bool renderFog = ( flag & LEVEL_FOG ) == LEVEL_FOG;
+#endif
+
+    std::vector<RouteMark> routeMarks = _getRouteMarks( flag );
+
+    // Find the tiles whose fog, objects or heroes have been changed, and the tiles of the old and the new route marks if the route has been changed.
+    std::vector<int32_t> changedTiles;
+    _updateTileStates( flag, &changedTiles );
+
+    if ( routeMarks != _routeMarks ) {
+        for ( const RouteMark & mark : _routeMarks ) {
+            changedTiles.push_back( mark.tileIndex );
+        }
+
+        for ( const RouteMark & mark : routeMarks ) {
+            changedTiles.push_back( mark.tileIndex );
+        }
+    }
+
+    // The visible area is split into square blocks of tiles and only the blocks affected by the changes are redrawn.
+    const int32_t blocksPerRow = ( tileROI.width + changeBlockSize - 1 ) / changeBlockSize;
+    const int32_t blocksPerColumn = ( tileROI.height + changeBlockSize - 1 ) / changeBlockSize;
+
+    std::vector<uint8_t> dirtyBlocks( static_cast<size_t>( blocksPerRow ) * blocksPerColumn, 0 );
+    int32_t dirtyBlockCount = 0;
+
+    // Marks the blocks containing the visible tiles from ('x' - 'before') to ('x' + 'after') and from ('y' - 'before') to ('y' + 'after').
+    const auto markBlocks = [&tileROI, &dirtyBlocks, &dirtyBlockCount, blocksPerRow]( const int32_t x, const int32_t y, const int32_t before, const int32_t after ) {
+        const int32_t firstX = std::max( x - before - tileROI.x, 0 );
+        const int32_t lastX = std::min( x + after - tileROI.x, tileROI.width - 1 );
+        const int32_t firstY = std::max( y - before - tileROI.y, 0 );
+        const int32_t lastY = std::min( y + after - tileROI.y, tileROI.height - 1 );
+
+        if ( firstX > lastX || firstY > lastY ) {
+            return;
+        }
+
+        for ( int32_t blockY = firstY / changeBlockSize; blockY <= lastY / changeBlockSize; ++blockY ) {
+            for ( int32_t blockX = firstX / changeBlockSize; blockX <= lastX / changeBlockSize; ++blockX ) {
+                uint8_t & block = dirtyBlocks[blockY * blocksPerRow + blockX];
+                if ( block == 0 ) {
+                    block = 1;
+                    ++dirtyBlockCount;
+                }
+            }
+        }
+    };
+
+    // Sprites of an object located on a tile can cover up to 2 tiles to the left and to the top and 1 tile to the right and to the bottom
+    // (the same assumption is used by the full redraw). Therefore, the tiles outside the visible area have to be checked as well.
+    const int32_t minX = std::max<int32_t>( tileROI.x - 1, 0 );
+    const int32_t minY = std::max<int32_t>( tileROI.y - 1, 0 );
+    const int32_t maxX = std::min( tileROI.x + tileROI.width + 2, worldWidth );
+    const int32_t maxY = std::min( tileROI.y + tileROI.height + 2, worldHeight );
+
+    for ( int32_t y = minY; y < maxY; ++y ) {
+        const int32_t offset = y * worldWidth;
+        for ( int32_t x = minX; x < maxX; ++x ) {
+            if ( isTileAnimated( world.getTile( x + offset ), renderFog ) ) {
+                markBlocks( x, y, 2, 1 );
+            }
+        }
+    }
+
+    // A changed tile could also contain a moving hero whose sprites are shifted by one more tile, or route marks which are not fit in one tile.
+    for ( const int32_t tileIndex : changedTiles ) {
+        markBlocks( tileIndex % worldWidth, tileIndex / worldWidth, 3, 2 );
+    }
+
+    if ( dirtyBlockCount * 4 > static_cast<int32_t>( dirtyBlocks.size() ) * 3 ) {
+        // Almost everything has been changed. Rendering of overlapping parts of the neighbouring blocks would be slower than a full redraw.
+        Redraw( dst, flag );
+        return;
+    }
+
+    std::vector<fheroes2::Rect> updatedAreas;
+
+    if ( viewShift != fheroes2::Point() ) {
+        // Move the kept frame according to the view shift and render only the uncovered parts of the Game Area.
+        if ( _scrollBuffer.width() != _backBuffer.width() || _scrollBuffer.height() != _backBuffer.height() ) {
+            _scrollBuffer._disableTransformLayer();
+            _scrollBuffer.resize( _backBuffer.width(), _backBuffer.height() );
+        }
+
+        const fheroes2::Rect keptArea = _windowROI ^ fheroes2::Rect{ _windowROI.x - viewShift.x, _windowROI.y - viewShift.y, _windowROI.width, _windowROI.height };
+        fheroes2::Copy( _backBuffer, keptArea.x + viewShift.x, keptArea.y + viewShift.y, _scrollBuffer, keptArea.x, keptArea.y, keptArea.width, keptArea.height );
+        std::swap( _backBuffer, _scrollBuffer );
+
+        if ( viewShift.x > 0 ) {
+            updatedAreas.emplace_back( _windowROI.x + _windowROI.width - viewShift.x, _windowROI.y, viewShift.x, _windowROI.height );
+        }
+        else if ( viewShift.x < 0 ) {
+            updatedAreas.emplace_back( _windowROI.x, _windowROI.y, -viewShift.x, _windowROI.height );
+        }
+
+        if ( viewShift.y > 0 ) {
+            updatedAreas.emplace_back( keptArea.x, _windowROI.y + _windowROI.height - viewShift.y, keptArea.width, viewShift.y );
+        }
+        else if ( viewShift.y < 0 ) {
+            updatedAreas.emplace_back( keptArea.x, _windowROI.y, keptArea.width, -viewShift.y );
+        }
+    }
+
+    for ( int32_t blockY = 0; blockY < blocksPerColumn; ++blockY ) {
+        int32_t blockX = 0;
 
+        while ( blockX < blocksPerRow ) {
+            if ( dirtyBlocks[blockY * blocksPerRow + blockX] == 0 ) {
+                ++blockX;
+                continue;
+            }
+
+            // Join all consecutive dirty blocks in a row into one area.
+            const int32_t firstBlockX = blockX;
+            while ( blockX < blocksPerRow && dirtyBlocks[blockY * blocksPerRow + blockX] != 0 ) {
+                ++blockX;
+            }
+
+            const fheroes2::Rect dirtyTileROI = tileROI
+                                                ^ fheroes2::Rect{ tileROI.x + firstBlockX * changeBlockSize, tileROI.y + blockY * changeBlockSize,
+                                                                  ( blockX - firstBlockX ) * changeBlockSize, changeBlockSize };
+            const fheroes2::Point dirtyAreaOffset = GetRelativeTilePosition( dirtyTileROI.getPosition() );
+            const fheroes2::Rect dirtyArea = _windowROI
+                                             ^ fheroes2::Rect{ dirtyAreaOffset.x, dirtyAreaOffset.y, dirtyTileROI.width * fheroes2::tileWidthPx,
+                                                               dirtyTileROI.height * fheroes2::tileWidthPx };
+            if ( dirtyArea.width > 0 && dirtyArea.height > 0 ) {
+                updatedAreas.push_back( dirtyArea );
+            }
+        }
+    }
+
+    _lastUpdatedArea = {};
+
+    for ( const fheroes2::Rect & area : updatedAreas ) {
+        _redrawArea( _backBuffer, area, flag, routeMarks );
+
+        _lastUpdatedArea = fheroes2::getBoundaryRect( _lastUpdatedArea, area );
+    }
+
+    if ( viewShift != fheroes2::Point() ) {
+        // The whole Game Area has been moved.
+        fheroes2::Copy( _backBuffer, _windowROI.x, _windowROI.y, dst, _windowROI.x, _windowROI.y, _windowROI.width, _windowROI.height );
+
+        _lastUpdatedArea = _windowROI;
+    }
+    else {
+        for ( const fheroes2::Rect & area : updatedAreas ) {
+            fheroes2::Copy( _backBuffer, area.x, area.y, dst, area.x, area.y, area.width, area.height );
+        }
+    }
+
+    _routeMarks = std::move( routeMarks );
+    _lastRedrawTopLeftTileOffset = _topLeftTileOffset;
+}
+
+void Interface::GameArea::_redrawArea( fheroes2::Image & dst, const fheroes2::Rect & area, const int flag, const std::vector<RouteMark> & routeMarks ) const
+{
+    const fheroes2::Point topLeft = getInternalPosition( area.getPosition() );
+    const fheroes2::Point bottomRight = getInternalPosition( { area.x + area.width - 1, area.y + area.height - 1 } );
+
+    const int32_t firstX = getTileCoordinate( topLeft.x );
+    const int32_t firstY = getTileCoordinate( topLeft.y );
+    const int32_t lastX = getTileCoordinate( bottomRight.x );
+    const int32_t lastY = getTileCoordinate( bottomRight.y );
+
+    // Render a wider area clipped by the given one to properly draw the parts of objects located on the neighbouring tiles.
+    const fheroes2::Rect tileROI{ firstX - 2, firstY - 2, lastX - firstX + 5, lastY - firstY + 5 };
+
+    _renderROI = area;
+
+    if ( tileROI.x + tileROI.width <= 0 || tileROI.y + tileROI.height <= 0 || tileROI.x >= world.w() || tileROI.y >= world.h() ) {
+        // There are no map tiles in this area.
+        for ( int32_t y = tileROI.y; y < tileROI.y + tileROI.height; ++y ) {
+            for ( int32_t x = tileROI.x; x < tileROI.x + tileROI.width; ++x ) {
+                Maps::redrawEmptyTile( dst, { x, y }, *this );
+            }
+        }
+    }
+    else {
+        _redrawTiles( dst, tileROI, flag, false, routeMarks );
+    }
+
+    _renderROI = _windowROI;
+}
+
+std::vector<Interface::GameArea::RouteMark> Interface::GameArea::_getRouteMarks( const int flag )
+{
+    std::vector<RouteMark> routeMarks;
+
+    const bool drawHeroes = ( flag & LEVEL_HEROES ) == LEVEL_HEROES;
+    const bool drawRoutes = ( flag & LEVEL_ROUTES ) != 0;
+
+    const Heroes * currentHero = drawHeroes ? GetFocusHeroes() : nullptr;
+
+    if ( !drawRoutes || currentHero == nullptr || !currentHero->GetPath().isShow() ) {
+        return routeMarks;
+    }
+
+    const Route::Path & path = currentHero->GetPath();
+    int32_t greenColorSteps = path.GetAllowedSteps();
+
+    const int32_t pathfinding = currentHero->GetLevelSkill( Skill::Secondary::PATHFINDING );
+
+    Route::Path::const_iterator currentStep = path.begin();
+    Route::Path::const_iterator nextStep = currentStep;
+
+    if ( currentHero->isMoveEnabled() && ( currentHero->GetDirection() == path.GetFrontDirection() ) ) {
+        // Do not draw the first path mark when hero / boat is moving in the direction of the path.
+        ++currentStep;
+        ++nextStep;
+        --greenColorSteps;
+    }
+
+    for ( ; currentStep != path.end(); ++currentStep ) {
+        const int32_t tileIndex = currentStep->GetIndex();
+
+        ++nextStep;
+        --greenColorSteps;
+
+        uint32_t routeSpriteIndex = 0;
+        if ( nextStep != path.end() ) {
+            const Maps::Tile & tile = world.getTile( tileIndex );
+            const uint32_t cost = tile.isRoad() ? Maps::Ground::roadPenalty : Maps::Ground::GetPenalty( tile, pathfinding );
+
+            routeSpriteIndex = Route::Path::GetIndexSprite( currentStep->GetDirection(), nextStep->GetDirection(), cost );
+        }
+
+        routeMarks.push_back( { tileIndex, ( ( greenColorSteps < 0 ) ? ICN::ROUTERED : ICN::ROUTE ), routeSpriteIndex } );
+    }
+
+    return routeMarks;
+}
+
+void Interface::GameArea::_updateTileStates( const int flag, std::vector<int32_t> * changedTiles ) const
+{
+    const size_t worldSize = world.getSize();
+    if ( _tileStates.size() != worldSize ) {
+        _tileStates.assign( worldSize, 0 );
+    }
+
+    const fheroes2::Rect tileROI = GetVisibleTileROI();
+    const int32_t worldWidth = world.w();
+
+#ifdef WITH_DEBUG
+    const bool renderFog = ( ( flag & LEVEL_FOG ) == LEVEL_FOG ) && !IS_DEVEL();
+#else
+    const bool renderFog = ( flag & LEVEL_FOG ) == LEVEL_FOG;
+#endif
+
+    // The same tiles are checked as for the animation.
+    const int32_t minX = std::max<int32_t>( tileROI.x - 1, 0 );
+    const int32_t minY = std::max<int32_t>( tileROI.y - 1, 0 );
+    const int32_t maxX = std::min( tileROI.x + tileROI.width + 2, worldWidth );
+    const int32_t maxY = std::min( tileROI.y + tileROI.height + 2, world.h() );
+
+    for ( int32_t y = minY; y < maxY; ++y ) {
+        const int32_t offset = y * worldWidth;
+        for ( int32_t x = minX; x < maxX; ++x ) {
+            const int32_t tileIndex = x + offset;
+            const uint64_t state = getTileRenderState( world.getTile( tileIndex ), renderFog );
+
+            if ( _tileStates[tileIndex] == state ) {
+                continue;
+            }
+
+            _tileStates[tileIndex] = state;
+
+            if ( changedTiles != nullptr ) {
+                changedTiles->push_back( tileIndex );
+            }
+        }
+    }
+}
+
+void Interface::GameArea::_redrawTiles( fheroes2::Image & dst, const fheroes2::Rect & tileROI, const int flag, const bool isPuzzleDraw,
+                                        const std::vector<RouteMark> & routeMarks ) const
+{
     int32_t maxX = tileROI.x + tileROI.width;
     int32_t maxY = tileROI.y + tileROI.height;
     const int32_t worldWidth = world.w();
@@ -420,6 +864,18 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
     const bool renderFog = ( flag & LEVEL_FOG ) == LEVEL_FOG;
 #endif
 
+    bool drawPassabilities = ( flag & LEVEL_PASSABILITIES );
+
+#ifdef WITH_DEBUG
+    if ( IS_DEVEL() && ( flag & LEVEL_ALL ) ) {
+        drawPassabilities = true;
+    }
+#endif
+
+    // Terrain and terrain layer objects are copied from the pre-rendered chunks when possible. Fading objects do not have a static look
+    // and the terrain under the fog must not be visible if the fog is not going to be rendered over it.
+    const bool useTerrainCache = !isPuzzleDraw && _animationInfo.empty() && ( !renderFog || !drawPassabilities );
+
     // Render terrain.
     for ( int32_t y = 0; y < tileROI.height; ++y ) {
         fheroes2::Point offset( tileROI.x, tileROI.y + y );
@@ -434,7 +890,7 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
                 if ( offset.x < 0 || offset.x >= worldWidth ) {
                     Maps::redrawEmptyTile( dst, offset, *this );
                 }
-                else {
+                else if ( !useTerrainCache ) {
                     const Maps::Tile & tile = world.getTile( offset.x, offset.y );
                     // Do not render terrain on the tiles fully covered with the fog.
                     if ( !renderFog || tile.getFogDirection() != DIRECTION_ALL ) {
@@ -456,6 +912,10 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
         return;
     }
 
+    if ( useTerrainCache ) {
+        _terrainCache.redraw( dst, { minX, minY, maxX - minX, maxY - minY }, renderFog, *this );
+    }
+
     // Each tile can contain multiple object parts or sprites. Each object part has its own level or in other words layer of rendering.
     // We need to use a correct order of levels to render objects on tiles. The levels are:
     // 0 - main and action objects like mines, forest, castle and etc.
@@ -608,8 +1068,10 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
                 continue;
             }
 
-            // Draw roads, rivers and cracks.
-            redrawBottomLayerObjects( tile, dst, isPuzzleDraw, *this, Maps::TERRAIN_LAYER );
+            if ( !useTerrainCache ) {
+                // Draw roads, rivers and cracks.
+                redrawBottomLayerObjects( tile, dst, isPuzzleDraw, *this, Maps::TERRAIN_LAYER );
+            }
 
             redrawBottomLayerObjects( tile, dst, isPuzzleDraw, *this, Maps::BACKGROUND_LAYER );
         }
@@ -704,61 +1166,20 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
     }
 
     // Draw hero's route. It should be drawn on top of everything.
-    const bool drawRoutes = ( flag & LEVEL_ROUTES ) != 0;
-
-    const Heroes * currentHero = drawHeroes ? GetFocusHeroes() : nullptr;
-
-    if ( drawRoutes && ( currentHero != nullptr ) && currentHero->GetPath().isShow() ) {
-        const Route::Path & path = currentHero->GetPath();
-        int32_t greenColorSteps = path.GetAllowedSteps();
-
-        const int32_t pathfinding = currentHero->GetLevelSkill( Skill::Secondary::PATHFINDING );
-
-        Route::Path::const_iterator currentStep = path.begin();
-        Route::Path::const_iterator nextStep = currentStep;
-
-        if ( currentHero->isMoveEnabled() && ( currentHero->GetDirection() == path.GetFrontDirection() ) ) {
-            // Do not draw the first path mark when hero / boat is moving in the direction of the path.
-            ++currentStep;
-            ++nextStep;
-            --greenColorSteps;
-        }
-
-        // Not all arrows and their shadows fit in 1 tile. We need to consider an area of 1 tile bigger to properly render everything.
-        const fheroes2::Rect extendedVisibleRoi{ tileROI.x - 1, tileROI.y - 1, tileROI.width + 2, tileROI.height + 2 };
-
-        for ( ; currentStep != path.end(); ++currentStep ) {
-            const int32_t tileIndex = currentStep->GetIndex();
-            const fheroes2::Point & mp = Maps::GetPoint( tileIndex );
+    // Not all arrows and their shadows fit in 1 tile. We need to consider an area of 1 tile bigger to properly render everything.
+    const fheroes2::Rect extendedVisibleRoi{ tileROI.x - 1, tileROI.y - 1, tileROI.width + 2, tileROI.height + 2 };
 
-            ++nextStep;
-            --greenColorSteps;
+    for ( const RouteMark & mark : routeMarks ) {
+        const fheroes2::Point & mp = Maps::GetPoint( mark.tileIndex );
 
-            if ( !( extendedVisibleRoi & mp ) ) {
-                // The mark is on a tile outside the drawing area. Just skip it.
-                continue;
-            }
-
-            uint32_t routeSpriteIndex = 0;
-            if ( nextStep != path.end() ) {
-                const Maps::Tile & tile = world.getTile( tileIndex );
-                const uint32_t cost = tile.isRoad() ? Maps::Ground::roadPenalty : Maps::Ground::GetPenalty( tile, pathfinding );
-
-                routeSpriteIndex = Route::Path::GetIndexSprite( currentStep->GetDirection(), nextStep->GetDirection(), cost );
-            }
-
-            const fheroes2::Sprite & routeSprite = Assets::getImage( ( ( greenColorSteps < 0 ) ? ICN::ROUTERED : ICN::ROUTE ), routeSpriteIndex );
-            BlitOnTile( dst, routeSprite, routeSprite.x() - 12, routeSprite.y() + 2, mp, false, 255 );
+        if ( !( extendedVisibleRoi & mp ) ) {
+            // The mark is on a tile outside the drawing area. Just skip it.
+            continue;
         }
-    }
 
-    bool drawPassabilities = ( flag & LEVEL_PASSABILITIES );
-
-#ifdef WITH_DEBUG
-    if ( IS_DEVEL() && ( flag & LEVEL_ALL ) ) {
-        drawPassabilities = true;
+        const fheroes2::Sprite & routeSprite = Assets::getImage( mark.icnId, mark.icnIndex );
+        BlitOnTile( dst, routeSprite, routeSprite.x() - 12, routeSprite.y() + 2, mp, false, 255 );
     }
-#endif
 
     if ( drawPassabilities ) {
         const PlayerColorsSet friendColors = Players::FriendColors();
@@ -793,8 +1214,6 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
             }
         }
     }
-
-    updateObjectAnimationInfo();
 }
 
 void Interface::GameArea::redrawOnlyFog( fheroes2::Image & dst ) const
@@ -30,6 +30,7 @@
 #include <vector>
 
 #include "image.h"
+#include "interface_terrain_cache.h"
 #include "math_base.h"
 #include "mp2.h"
 #include "timing.h"
@@ -199,6 +200,18 @@ namespace Interface
         // Interface::BaseInterface::Redraw() instead to avoid issues in the "no interface" mode
         void Redraw( fheroes2::Image & dst, int flag, bool isPuzzleDraw = false ) const;
 
+        // Redraws only the parts of the Game Area which have been changed since the previous frame: the tiles with animated objects and
+        // the tiles whose fog, objects, heroes or hero route marks have been changed. The previous frame is kept in a back buffer, so if
+        // the view has been shifted, then it is scrolled and only the uncovered parts are rendered. If the previous frame was not rendered
+        // with the same parameters a full redraw is done instead.
+        void redrawChangedTiles( fheroes2::Image & dst, const int flag ) const;
+
+        // Returns the area in pixels which has been updated by the last call of Redraw() or redrawChangedTiles().
+        const fheroes2::Rect & getLastUpdatedArea() const
+        {
+            return _lastUpdatedArea;
+        }
+
         void redrawOnlyFog( fheroes2::Image & dst ) const;
 
         void renderTileAreaSelect( fheroes2::Image & dst, const int32_t startTile, const int32_t endTile, const bool isActionObject ) const;
@@ -211,6 +224,9 @@ namespace Interface
         // Use this method to draw TIL images
         void DrawTile( fheroes2::Image & src, const fheroes2::Image & dst, const fheroes2::Point & mp ) const;
 
+        // Use this method to draw a part of an image consisting of TIL images. The top-left corner of the part is drawn at the given tile.
+        void DrawTile( fheroes2::Image & dst, const fheroes2::Image & src, const fheroes2::Rect & srcRoi, const fheroes2::Point & mp ) const;
+
         void SetUpdateCursor()
         {
             updateCursor = true;
@@ -273,9 +289,25 @@ namespace Interface
         }
 
     private:
+        struct RouteMark
+        {
+            int32_t tileIndex{ -1 };
+            int icnId{ 0 };
+            uint32_t icnIndex{ 0 };
+
+            bool operator==( const RouteMark & other ) const
+            {
+                return tileIndex == other.tileIndex && icnId == other.icnId && icnIndex == other.icnIndex;
+            }
+        };
+
         BaseInterface & _interface;
 
         fheroes2::Rect _windowROI; // visible to draw area of World Map in pixels
+
+        // All tile rendering is clipped by this area. It differs from the window ROI only during the partial redraw.
+        mutable fheroes2::Rect _renderROI;
+
         fheroes2::Point _topLeftTileOffset; // offset of tiles to be drawn (from here we can find any tile ID)
 
         // boundaries for World Map
@@ -305,6 +337,30 @@ namespace Interface
 
         fheroes2::UIScrollInertia _inertiaHandler;
 
+        // The parameters of the last full redraw. They are used to verify that the partial redraw can be done over the previous frame.
+        mutable const fheroes2::Image * _lastRedrawImage{ nullptr };
+        mutable fheroes2::Size _lastRedrawImageSize;
+        mutable int _lastRedrawFlag{ 0 };
+        mutable fheroes2::Point _lastRedrawTopLeftTileOffset;
+        mutable fheroes2::Rect _lastRedrawWindowROI;
+
+        mutable fheroes2::Rect _lastUpdatedArea;
+
+        // The Game Area part of the last rendered frame. Unlike the target image it never contains anything rendered over the Game Area.
+        mutable fheroes2::Image _backBuffer;
+        // It is used to scroll the back buffer.
+        mutable fheroes2::Image _scrollBuffer;
+
+        // The render states of the map tiles and the route marks in the last rendered frame. They are used to find the changed tiles.
+        mutable std::vector<uint64_t> _tileStates;
+        mutable std::vector<RouteMark> _routeMarks;
+
+        // This member needs to be mutable because it is updated during rendering.
+        mutable TerrainChunkCache _terrainCache;
+
+        // The size of a square block of tiles used to track the changed areas.
+        static const int32_t changeBlockSize{ 4 };
+
         // Returns middle point of window ROI.
         fheroes2::Point _middlePoint() const
         {
@@ -316,5 +372,18 @@ namespace Interface
         void _setCenterToTile( const fheroes2::Point & tile ); // set center to the middle of tile (input is tile ID)
 
         void updateObjectAnimationInfo() const;
+
+        void _redrawTiles( fheroes2::Image & dst, const fheroes2::Rect & tileROI, const int flag, const bool isPuzzleDraw,
+                           const std::vector<RouteMark> & routeMarks ) const;
+
+        // Renders the given area of the Game Area in pixels. All the objects partially covering this area are rendered as well.
+        void _redrawArea( fheroes2::Image & dst, const fheroes2::Rect & area, const int flag, const std::vector<RouteMark> & routeMarks ) const;
+
+        // Returns the route marks of the focused hero rendered with the given flags.
+        static std::vector<RouteMark> _getRouteMarks( const int flag );
+
+        // Updates the render states of the tiles which can affect the visible part of the Game Area. The tiles whose states have
+        // been changed are added to 'changedTiles' if it is provided.
+        void _updateTileStates( const int flag, std::vector<int32_t> * changedTiles ) const;
     };
 }
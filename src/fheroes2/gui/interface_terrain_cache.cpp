@@ -0,0 +1,183 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "interface_terrain_cache.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+#include "direction.h"
+#include "interface_gamearea.h"
+#include "maps_tiles.h"
+#include "maps_tiles_render.h"
+#include "mp2.h"
+#include "ui_constants.h"
+#include "world.h"
+
+namespace
+{
+    // The size of a chunk side in tiles.
+    const int32_t chunkSize{ 16 };
+
+    // The cache keeps at least this number of chunks even if fewer chunks are visible.
+    const size_t minChunkCount{ 16 };
+
+    // Returns a hash of all the data which affects the pre-rendered image of the tile.
+    uint64_t getTileSignature( const Maps::Tile & tile )
+    {
+        // FNV-1a hash.
+        uint64_t signature = 14695981039346656037ULL;
+
+        const auto combine = [&signature]( const uint32_t value ) { signature = ( signature ^ value ) * 1099511628211ULL; };
+
+        combine( tile.getTerrainImageIndex() );
+        combine( tile.getTerrainFlags() & 0x3 );
+
+        for ( const auto & part : tile.getGroundObjectParts() ) {
+            if ( part.layerType == Maps::TERRAIN_LAYER ) {
+                combine( part.icnType );
+                combine( part.icnIndex );
+            }
+        }
+
+        const Maps::ObjectPart & mainPart = tile.getMainObjectPart();
+        if ( mainPart.icnType != MP2::OBJ_ICN_TYPE_UNKNOWN && mainPart.layerType == Maps::TERRAIN_LAYER ) {
+            // The main object part is rendered after all ground parts. Use a value which is not a valid ICN type or index to separate them.
+            combine( 0x100 );
+            combine( mainPart.icnType );
+            combine( mainPart.icnIndex );
+            combine( tile.getMainObjectType() );
+        }
+
+        return signature;
+    }
+}
+
+void Interface::TerrainChunkCache::redraw( fheroes2::Image & dst, const fheroes2::Rect & tileROI, const bool renderFog, const GameArea & area )
+{
+    const int32_t worldWidth = world.w();
+    const int32_t worldHeight = world.h();
+
+    assert( tileROI.x >= 0 && tileROI.y >= 0 && tileROI.x + tileROI.width <= worldWidth && tileROI.y + tileROI.height <= worldHeight );
+
+    if ( tileROI.width <= 0 || tileROI.height <= 0 ) {
+        return;
+    }
+
+    if ( _worldSize != fheroes2::Size( worldWidth, worldHeight ) ) {
+        _chunks.clear();
+        _worldSize = { worldWidth, worldHeight };
+    }
+
+    const int32_t chunksPerRow = ( worldWidth + chunkSize - 1 ) / chunkSize;
+
+    const int32_t firstChunkX = tileROI.x / chunkSize;
+    const int32_t firstChunkY = tileROI.y / chunkSize;
+    const int32_t lastChunkX = ( tileROI.x + tileROI.width - 1 ) / chunkSize;
+    const int32_t lastChunkY = ( tileROI.y + tileROI.height - 1 ) / chunkSize;
+
+    ++_usageCounter;
+
+    std::vector<std::pair<const Chunk *, fheroes2::Rect>> chunksWithDynamicTiles;
+
+    for ( int32_t chunkY = firstChunkY; chunkY <= lastChunkY; ++chunkY ) {
+        for ( int32_t chunkX = firstChunkX; chunkX <= lastChunkX; ++chunkX ) {
+            const fheroes2::Rect chunkTileROI{ chunkX * chunkSize, chunkY * chunkSize, std::min( chunkSize, worldWidth - chunkX * chunkSize ),
+                                               std::min( chunkSize, worldHeight - chunkY * chunkSize ) };
+
+            Chunk & chunk = _chunks[chunkY * chunksPerRow + chunkX];
+            chunk.lastUsage = _usageCounter;
+
+            if ( chunk.image.empty() ) {
+                chunk.image.resize( chunkTileROI.width * fheroes2::tileWidthPx, chunkTileROI.height * fheroes2::tileWidthPx );
+                chunk.image._disableTransformLayer();
+
+                // Zero signature is practically impossible so all tiles are going to be rendered.
+                chunk.tileSignatures.assign( static_cast<size_t>( chunkTileROI.width ) * chunkTileROI.height, 0 );
+                chunk.isTileDynamic.assign( chunk.tileSignatures.size(), 0 );
+            }
+
+            // Only the tiles within the given ROI are verified and rendered.
+            const fheroes2::Rect roi = chunkTileROI ^ tileROI;
+            bool hasDynamicTiles = false;
+
+            for ( int32_t y = roi.y; y < roi.y + roi.height; ++y ) {
+                for ( int32_t x = roi.x; x < roi.x + roi.width; ++x ) {
+                    const Maps::Tile & tile = world.getTile( x, y );
+                    const size_t tileId = static_cast<size_t>( y - chunkTileROI.y ) * chunkTileROI.width + ( x - chunkTileROI.x );
+
+                    const uint64_t signature = getTileSignature( tile );
+                    if ( chunk.tileSignatures[tileId] != signature ) {
+                        chunk.tileSignatures[tileId] = signature;
+
+                        const fheroes2::Point offset{ ( x - chunkTileROI.x ) * fheroes2::tileWidthPx, ( y - chunkTileROI.y ) * fheroes2::tileWidthPx };
+                        chunk.isTileDynamic[tileId] = Maps::redrawTerrainWithStaticObjects( tile, chunk.image, offset ) ? 0 : 1;
+                    }
+
+                    hasDynamicTiles = hasDynamicTiles || ( chunk.isTileDynamic[tileId] != 0 );
+                }
+            }
+
+            const fheroes2::Rect imageRoi{ ( roi.x - chunkTileROI.x ) * fheroes2::tileWidthPx, ( roi.y - chunkTileROI.y ) * fheroes2::tileWidthPx,
+                                           roi.width * fheroes2::tileWidthPx, roi.height * fheroes2::tileWidthPx };
+            area.DrawTile( dst, chunk.image, imageRoi, roi.getPosition() );
+
+            if ( hasDynamicTiles ) {
+                chunksWithDynamicTiles.emplace_back( &chunk, roi );
+            }
+        }
+    }
+
+    // Animated terrain layer objects are rendered after all chunks as some of them (like flags) might not fit into a tile.
+    for ( const auto & [chunk, roi] : chunksWithDynamicTiles ) {
+        const int32_t chunkTileX = ( roi.x / chunkSize ) * chunkSize;
+        const int32_t chunkTileY = ( roi.y / chunkSize ) * chunkSize;
+        const int32_t chunkWidth = std::min( chunkSize, worldWidth - chunkTileX );
+
+        for ( int32_t y = roi.y; y < roi.y + roi.height; ++y ) {
+            for ( int32_t x = roi.x; x < roi.x + roi.width; ++x ) {
+                if ( chunk->isTileDynamic[static_cast<size_t>( y - chunkTileY ) * chunkWidth + ( x - chunkTileX )] == 0 ) {
+                    continue;
+                }
+
+                const Maps::Tile & tile = world.getTile( x, y );
+                if ( renderFog && ( tile.getFogDirection() == DIRECTION_ALL ) ) {
+                    continue;
+                }
+
+                Maps::redrawBottomLayerObjects( tile, dst, false, area, Maps::TERRAIN_LAYER );
+            }
+        }
+    }
+
+    // Keep twice as many chunks as currently visible to avoid rendering of the same chunks while scrolling back and forth.
+    const size_t visibleChunkCount = static_cast<size_t>( lastChunkX - firstChunkX + 1 ) * ( lastChunkY - firstChunkY + 1 );
+    _evictUnusedChunks( std::max( minChunkCount, 2 * visibleChunkCount ) );
+}
+
+void Interface::TerrainChunkCache::_evictUnusedChunks( const size_t maxChunkCount )
+{
+    while ( _chunks.size() > maxChunkCount ) {
+        const auto oldestChunk = std::min_element( _chunks.begin(), _chunks.end(),
+                                                   []( const auto & first, const auto & second ) { return first.second.lastUsage < second.second.lastUsage; } );
+        _chunks.erase( oldestChunk );
+    }
+}
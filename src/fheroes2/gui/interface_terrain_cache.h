@@ -0,0 +1,77 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "image.h"
+#include "math_base.h"
+
+namespace Interface
+{
+    class GameArea;
+
+    // Keeps the terrain and static terrain layer objects (roads, rivers and cracks) of the world map pre-rendered in square chunks of tiles,
+    // so they can be rendered by copying a few big images instead of rendering every tile separately.
+    class TerrainChunkCache
+    {
+    public:
+        TerrainChunkCache() = default;
+
+        // Pre-rendered images are not copied. A copy of the cache starts empty.
+        TerrainChunkCache( const TerrainChunkCache & /* unused */ )
+        {
+            // Do nothing.
+        }
+
+        ~TerrainChunkCache() = default;
+
+        TerrainChunkCache & operator=( const TerrainChunkCache & ) = delete;
+
+        // Renders the terrain and terrain layer objects of the tiles within the given ROI which must be within the world map.
+        // Terrain layer objects of the tiles fully covered by the fog are not rendered if the fog is going to be rendered.
+        void redraw( fheroes2::Image & dst, const fheroes2::Rect & tileROI, const bool renderFog, const GameArea & area );
+
+    private:
+        struct Chunk
+        {
+            fheroes2::Image image;
+
+            // The signature of every tile at the moment of its rendering into the chunk image.
+            std::vector<uint64_t> tileSignatures;
+
+            // Tiles with animated terrain layer objects. Only their terrain is pre-rendered.
+            std::vector<uint8_t> isTileDynamic;
+
+            uint64_t lastUsage{ 0 };
+        };
+
+        std::map<int32_t, Chunk> _chunks;
+
+        fheroes2::Size _worldSize;
+
+        uint64_t _usageCounter{ 0 };
+
+        void _evictUnusedChunks( const size_t maxChunkCount );
+    };
+}
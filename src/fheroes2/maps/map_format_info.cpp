@@ -489,12 +489,20 @@ namespace
             return false;
         }
 
-        RWStreamBuf compressed;
-        compressed.setBigendian( true );
-
-        compressed << map.additionalInfo << map.tiles << map.dailyEvents << map.rumors << map.castleMetadata << map.heroMetadata << map.sphinxMetadata << map.signMetadata
+        const auto writeCompressedData = [&map]( OStreamBase & output ) {
+            output << map.additionalInfo << map.tiles << map.dailyEvents << map.rumors << map.castleMetadata << map.heroMetadata << map.sphinxMetadata << map.signMetadata
                    << map.adventureMapEventMetadata << map.selectionObjectMetadata << map.capturableObjectsMetadata << map.monsterMetadata << map.artifactMetadata
                    << map.resourceMetadata << map.translationInfo;
+        };
+
+        // The size of data is calculated first to avoid multiple reallocations of the buffer for large maps.
+        StreamSizeCounter sizeCounter;
+        writeCompressedData( sizeCounter );
+
+        RWStreamBuf compressed( sizeCounter.size() );
+        compressed.setBigendian( true );
+
+        writeCompressedData( compressed );
 
         const std::vector<uint8_t> temp = Compression::zipData( compressed.data(), compressed.size(), false );
 
@@ -42,6 +42,7 @@
 #include "logging.h"
 #include "map_format_helper.h"
 #include "map_format_info.h"
+#include "maps_fileinfo_cache.h"
 #include "maps_tiles.h"
 #include "maps_tiles_helper.h"
 #include "mp2.h"
@@ -78,20 +79,20 @@ namespace
             = isOriginalMapFormat
               && ( fheroes2::getCurrentLanguage() == fheroes2::SupportedLanguage::French && fheroes2::getResourceLanguage() == fheroes2::SupportedLanguage::French );
 
-        for ( const std::string & mapFile : mapFiles ) {
-            Maps::FileInfo fi;
+        // Map files are read in parallel and only if they have been changed since the last time.
+        MapsFileInfoList fileInfos;
 
-            if ( isOriginalMapFormat ) {
-                if ( !fi.readMP2Map( mapFile, false ) ) {
-                    continue;
-                }
-            }
-            else {
-                if ( !fi.readResurrectionMap( mapFile, false, currentLanguage ) ) {
-                    continue;
-                }
-            }
+        if ( isOriginalMapFormat ) {
+            fileInfos = Maps::getCachedFileInfos(
+                mapFiles, "mp2", []( std::string filePath, Maps::FileInfo & fi ) { return fi.readMP2Map( std::move( filePath ), false ); }, true );
+        }
+        else {
+            fileInfos = Maps::getCachedFileInfos(
+                mapFiles, "fh2m_" + std::to_string( static_cast<int>( currentLanguage ) ),
+                [currentLanguage]( std::string filePath, Maps::FileInfo & fi ) { return fi.readResurrectionMap( std::move( filePath ), false, currentLanguage ); }, true );
+        }
 
+        for ( Maps::FileInfo & fi : fileInfos ) {
             const int humanOnlyColorsCount = Color::Count( fi.HumanOnlyColors() );
             if ( humanOnlyColorsCount > humanPlayerCount ) {
                 // This map requires more human-only players than needed.
@@ -772,14 +773,13 @@ MapsFileInfoList Maps::getEditorMapFileInfos()
     std::multimap<std::string, Maps::FileInfo, std::less<>> sortedMaps;
     const auto currentLanguage = fheroes2::getCurrentLanguage();
 
-    for ( const std::string & mapFile : maps ) {
-        Maps::FileInfo fi;
-
-        if ( !fi.readResurrectionMap( mapFile, true, currentLanguage ) ) {
-            continue;
-        }
+    MapsFileInfoList fileInfos = getCachedFileInfos(
+        maps, "fh2m_editor", [currentLanguage]( std::string filePath, Maps::FileInfo & fi ) { return fi.readResurrectionMap( std::move( filePath ), true, currentLanguage ); },
+        true );
 
-        sortedMaps.emplace( StringLower( System::GetFileName( mapFile ) ), std::move( fi ) );
+    for ( Maps::FileInfo & fi : fileInfos ) {
+        std::string fileName = StringLower( System::GetFileName( fi.filename ) );
+        sortedMaps.emplace( std::move( fileName ), std::move( fi ) );
     }
 
     if ( sortedMaps.empty() ) {
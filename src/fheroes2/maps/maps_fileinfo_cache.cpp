@@ -0,0 +1,332 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "maps_fileinfo_cache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "dir.h"
+#include "game_io.h"
+#include "logging.h"
+#include "save_format_version.h"
+#include "serialize.h"
+#include "system.h"
+
+namespace
+{
+    const std::string cacheFileName{ "file_info.cache" };
+
+    const uint32_t cacheFileMagicNumber{ 0x46494331 };
+
+    // This version must be increased every time the layout of cache entries is changed.
+    const uint16_t cacheFormatVersion{ 2 };
+
+    struct CacheEntry
+    {
+        uint64_t fileSize{ 0 };
+        int64_t modificationTime{ 0 };
+
+        // Whether the reader succeeded. The failures are cached as well in order to not read invalid files again and again.
+        bool isValid{ false };
+
+        Maps::FileInfo info;
+    };
+
+    // The key is a pair of the group and the path to the file.
+    using CacheEntries = std::map<std::pair<std::string, std::string>, CacheEntry, std::less<>>;
+
+    void put64( OStreamBase & stream, const uint64_t value )
+    {
+        stream << static_cast<uint32_t>( value >> 32 ) << static_cast<uint32_t>( value & 0xFFFFFFFF );
+    }
+
+    uint64_t get64( IStreamBase & stream )
+    {
+        uint32_t high = 0;
+        uint32_t low = 0;
+        stream >> high >> low;
+
+        return ( static_cast<uint64_t>( high ) << 32 ) | low;
+    }
+
+    class FileInfoCache
+    {
+    public:
+        static FileInfoCache & get()
+        {
+            static FileInfoCache cache;
+            return cache;
+        }
+
+        CacheEntries & entries()
+        {
+            if ( !_isLoaded ) {
+                _isLoaded = true;
+                _load();
+            }
+
+            return _entries;
+        }
+
+        void save() const;
+
+    private:
+        CacheEntries _entries;
+
+        bool _isLoaded{ false };
+
+        static std::string _getFilePath()
+        {
+            return System::concatPath( System::GetDataDirectory( "fheroes2" ), cacheFileName );
+        }
+
+        void _load();
+    };
+
+    void FileInfoCache::_load()
+    {
+        _entries.clear();
+
+        StreamFile fileStream;
+        fileStream.setBigendian( true );
+
+        if ( !fileStream.open( _getFilePath(), "rb" ) ) {
+            // The cache has not been created yet.
+            return;
+        }
+
+        uint32_t magicNumber = 0;
+        uint16_t cacheVersion = 0;
+        uint16_t formatVersion = 0;
+        uint32_t entryCount = 0;
+
+        fileStream >> magicNumber >> cacheVersion >> formatVersion >> entryCount;
+
+        if ( fileStream.fail() || magicNumber != cacheFileMagicNumber || cacheVersion != cacheFormatVersion || formatVersion != CURRENT_FORMAT_VERSION ) {
+            // The cache is either corrupted or created by another version of the game. Just read all the files again.
+            DEBUG_LOG( DBG_GAME, DBG_INFO, "The file info cache is outdated and will be rebuilt." )
+            return;
+        }
+
+        // The file information is serialized using the current version of the save format.
+        const uint16_t saveFileVersion = Game::GetVersionOfCurrentSaveFile();
+        Game::SetVersionOfCurrentSaveFile( CURRENT_FORMAT_VERSION );
+
+        for ( uint32_t i = 0; i < entryCount; ++i ) {
+            std::string group;
+            std::string filePath;
+            CacheEntry entry;
+
+            fileStream >> group >> filePath;
+
+            entry.fileSize = get64( fileStream );
+            entry.modificationTime = static_cast<int64_t>( get64( fileStream ) );
+
+            fileStream >> entry.isValid;
+
+            if ( entry.isValid ) {
+                // The list of translations is not a part of the serialized file information.
+                fileStream >> entry.info >> entry.info.translations;
+
+                // Only the name of the file is serialized as a part of the file information.
+                entry.info.filename = filePath;
+            }
+
+            if ( fileStream.fail() ) {
+                ERROR_LOG( "The file info cache is corrupted." )
+                _entries.clear();
+                break;
+            }
+
+            _entries.emplace( std::make_pair( std::move( group ), std::move( filePath ) ), std::move( entry ) );
+        }
+
+        Game::SetVersionOfCurrentSaveFile( saveFileVersion );
+    }
+
+    void FileInfoCache::save() const
+    {
+        assert( _isLoaded );
+
+        const std::string filePath = _getFilePath();
+
+        StreamFile fileStream;
+        fileStream.setBigendian( true );
+
+        if ( !fileStream.open( filePath, "wb" ) ) {
+            DEBUG_LOG( DBG_GAME, DBG_WARN, "Error opening the file " << filePath )
+            return;
+        }
+
+        fileStream << cacheFileMagicNumber << cacheFormatVersion << static_cast<uint16_t>( CURRENT_FORMAT_VERSION ) << static_cast<uint32_t>( _entries.size() );
+
+        for ( const auto & [key, entry] : _entries ) {
+            fileStream << key.first << key.second;
+
+            put64( fileStream, entry.fileSize );
+            put64( fileStream, static_cast<uint64_t>( entry.modificationTime ) );
+
+            fileStream << entry.isValid;
+
+            if ( entry.isValid ) {
+                fileStream << entry.info << entry.info.translations;
+            }
+        }
+
+        if ( fileStream.fail() ) {
+            ERROR_LOG( "Error writing the file " << filePath )
+
+            fileStream.close();
+            System::Unlink( filePath );
+        }
+    }
+
+    // Calls the given function for each index in [0, count) using all available hardware threads.
+    void runInParallel( const size_t count, const std::function<void( size_t )> & function )
+    {
+        const size_t threadCount = std::min<size_t>( count, std::max( std::thread::hardware_concurrency(), 1U ) );
+        if ( threadCount <= 1 ) {
+            for ( size_t i = 0; i < count; ++i ) {
+                function( i );
+            }
+
+            return;
+        }
+
+        std::atomic<size_t> nextIndex{ 0 };
+
+        const auto worker = [&nextIndex, &function, count]() {
+            for ( size_t i = nextIndex++; i < count; i = nextIndex++ ) {
+                function( i );
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve( threadCount - 1 );
+
+        for ( size_t i = 1; i < threadCount; ++i ) {
+            threads.emplace_back( worker );
+        }
+
+        // The current thread does its part of the work as well.
+        worker();
+
+        for ( std::thread & thread : threads ) {
+            thread.join();
+        }
+    }
+}
+
+MapsFileInfoList Maps::getCachedFileInfos( const ListFiles & files, const std::string_view group, const std::function<bool( std::string, FileInfo & )> & reader,
+                                           const bool isReaderThreadSafe )
+{
+    CacheEntries & entries = FileInfoCache::get().entries();
+
+    bool isCacheChanged = false;
+
+    // Remove the entries of files which no longer belong to this group.
+    const std::set<std::string_view> filePaths( files.begin(), files.end() );
+
+    for ( auto iter = entries.begin(); iter != entries.end(); ) {
+        if ( iter->first.first == group && filePaths.count( iter->first.second ) == 0 ) {
+            iter = entries.erase( iter );
+            isCacheChanged = true;
+        }
+        else {
+            ++iter;
+        }
+    }
+
+    std::vector<CacheEntry *> fileEntries;
+    fileEntries.reserve( files.size() );
+
+    std::vector<std::pair<const std::string *, CacheEntry *>> filesToRead;
+
+    for ( const std::string & filePath : files ) {
+        CacheEntry & entry = entries[std::make_pair( std::string( group ), filePath )];
+        fileEntries.push_back( &entry );
+
+        uint64_t fileSize = 0;
+        int64_t modificationTime = 0;
+
+        if ( !System::getFileSizeAndModificationTime( filePath, fileSize, modificationTime ) ) {
+            // The file cannot be accessed.
+            entry = {};
+            continue;
+        }
+
+        if ( entry.fileSize == fileSize && entry.modificationTime == modificationTime ) {
+            // The file has not been changed since it was read last time.
+            continue;
+        }
+
+        entry.fileSize = fileSize;
+        entry.modificationTime = modificationTime;
+
+        filesToRead.emplace_back( &filePath, &entry );
+    }
+
+    if ( !filesToRead.empty() ) {
+        DEBUG_LOG( DBG_GAME, DBG_INFO, "Reading " << filesToRead.size() << " of " << files.size() << " files of the '" << group << "' group." )
+
+        const auto readFile = [&filesToRead, &reader]( const size_t index ) {
+            const auto & [filePath, entry] = filesToRead[index];
+
+            entry->info = {};
+            entry->isValid = reader( *filePath, entry->info );
+        };
+
+        if ( isReaderThreadSafe ) {
+            runInParallel( filesToRead.size(), readFile );
+        }
+        else {
+            for ( size_t i = 0; i < filesToRead.size(); ++i ) {
+                readFile( i );
+            }
+        }
+
+        isCacheChanged = true;
+    }
+
+    if ( isCacheChanged ) {
+        FileInfoCache::get().save();
+    }
+
+    MapsFileInfoList result;
+    result.reserve( fileEntries.size() );
+
+    for ( const CacheEntry * entry : fileEntries ) {
+        if ( entry->isValid ) {
+            result.push_back( entry->info );
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,41 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "maps_fileinfo.h"
+
+struct ListFiles;
+
+namespace Maps
+{
+    // Returns the information of the given files in the same order, skipping the files which cannot be read. The information is taken
+    // from the persistent on-disk cache for files which have not been changed (by their size and modification time) since they were
+    // read last time, all other files are read by the given reader. If 'isReaderThreadSafe' is set then files are read in parallel.
+    //
+    // The 'group' must uniquely identify the reader and all its parameters affecting the result, such as the language. Cached entries
+    // of this group for files which are not in the given list are removed.
+    MapsFileInfoList getCachedFileInfos( const ListFiles & files, const std::string_view group, const std::function<bool( std::string, FileInfo & )> & reader,
+                                         const bool isReaderThreadSafe );
+}
@@ -485,7 +485,7 @@ void Maps::Tile::setBoat( const int direction, const PlayerColor color )
 {
     if ( _mainObjectPart.icnType != MP2::OBJ_ICN_TYPE_UNKNOWN ) {
         // It is important to preserve the order of objects for rendering purposes. Therefore, the main object should go to the front of objects.
-        _groundObjectPart.emplace_front( _mainObjectPart );
+        _groundObjectPart.emplace( _groundObjectPart.begin(), _mainObjectPart );
     }
 
     // If this assertion blows up then you are trying to put a boat on land!
@@ -839,11 +839,11 @@ void Maps::Tile::sortObjectParts()
 
     // Push everything to the container and sort it by level.
     if ( _mainObjectPart.icnType != MP2::OBJ_ICN_TYPE_UNKNOWN ) {
-        _groundObjectPart.emplace_front( _mainObjectPart );
+        _groundObjectPart.emplace( _groundObjectPart.begin(), _mainObjectPart );
     }
 
-    // Sort by internal layers.
-    _groundObjectPart.sort( []( const auto & left, const auto & right ) { return ( left.layerType > right.layerType ); } );
+    // Sort by internal layers. The order of parts within the same layer must be preserved.
+    std::stable_sort( _groundObjectPart.begin(), _groundObjectPart.end(), []( const auto & left, const auto & right ) { return ( left.layerType > right.layerType ); } );
 
     if ( !_groundObjectPart.empty() ) {
         auto highestPriorityPartIter = _groundObjectPart.end();
@@ -1284,8 +1284,8 @@ void Maps::Tile::updateFlag( const PlayerColor color, const uint8_t objectSprite
     // Flag deletion or installation must be done in relation to object UID as flag is attached to the object.
     if ( color == PlayerColor::NONE ) {
         const auto isFlag = [uid]( const auto & part ) { return part._uid == uid && part.icnType == MP2::OBJ_ICN_TYPE_FLAG32; };
-        _groundObjectPart.remove_if( isFlag );
-        _topObjectPart.remove_if( isFlag );
+        _groundObjectPart.erase( std::remove_if( _groundObjectPart.begin(), _groundObjectPart.end(), isFlag ), _groundObjectPart.end() );
+        _topObjectPart.erase( std::remove_if( _topObjectPart.begin(), _topObjectPart.end(), isFlag ), _topObjectPart.end() );
         return;
     }
 
@@ -1451,15 +1451,17 @@ bool Maps::Tile::removeObjectPartsByUID( const uint32_t objectUID )
 {
     bool isObjectPartRemoved = false;
 
-    size_t partCountBefore = _groundObjectPart.size();
-    _groundObjectPart.remove_if( [objectUID]( const auto & v ) { return v._uid == objectUID; } );
-    if ( partCountBefore != _groundObjectPart.size() ) {
+    const auto isObjectPart = [objectUID]( const auto & v ) { return v._uid == objectUID; };
+
+    auto groundPartIter = std::remove_if( _groundObjectPart.begin(), _groundObjectPart.end(), isObjectPart );
+    if ( groundPartIter != _groundObjectPart.end() ) {
+        _groundObjectPart.erase( groundPartIter, _groundObjectPart.end() );
         isObjectPartRemoved = true;
     }
 
-    partCountBefore = _topObjectPart.size();
-    _topObjectPart.remove_if( [objectUID]( const auto & v ) { return v._uid == objectUID; } );
-    if ( partCountBefore != _topObjectPart.size() ) {
+    auto topPartIter = std::remove_if( _topObjectPart.begin(), _topObjectPart.end(), isObjectPart );
+    if ( topPartIter != _topObjectPart.end() ) {
+        _topObjectPart.erase( topPartIter, _topObjectPart.end() );
         isObjectPartRemoved = true;
     }
 
@@ -1488,8 +1490,11 @@ bool Maps::Tile::removeObjectPartsByUID( const uint32_t objectUID )
 
         // Update passability based on initial passability.
         updatePassability();
+        world.getPortalGraph().invalidateTile( _index );
+
         for ( const int32_t tileIndex : tilesAround ) {
             world.getTile( tileIndex ).updatePassability();
+            world.getPortalGraph().invalidateTile( tileIndex );
         }
 
         if ( Heroes::isValidId( _occupantHeroId ) ) {
@@ -1510,8 +1515,10 @@ bool Maps::Tile::removeObjectPartsByUID( const uint32_t objectUID )
 
 void Maps::Tile::removeObjects( const MP2::ObjectIcnType objectIcnType )
 {
-    _groundObjectPart.remove_if( [objectIcnType]( const auto & part ) { return part.icnType == objectIcnType; } );
-    _topObjectPart.remove_if( [objectIcnType]( const auto & part ) { return part.icnType == objectIcnType; } );
+    const auto isObjectIcnType = [objectIcnType]( const auto & part ) { return part.icnType == objectIcnType; };
+
+    _groundObjectPart.erase( std::remove_if( _groundObjectPart.begin(), _groundObjectPart.end(), isObjectIcnType ), _groundObjectPart.end() );
+    _topObjectPart.erase( std::remove_if( _topObjectPart.begin(), _topObjectPart.end(), isObjectIcnType ), _topObjectPart.end() );
 
     if ( _mainObjectPart.icnType == objectIcnType ) {
         _mainObjectPart = {};
@@ -25,7 +25,6 @@
 
 #include <array>
 #include <cstdint>
-#include <list>
 #include <string>
 #include <vector>
 
@@ -261,17 +260,17 @@ namespace Maps
             _topObjectPart.emplace_back( part );
         }
 
-        const std::list<ObjectPart> & getGroundObjectParts() const
+        const std::vector<ObjectPart> & getGroundObjectParts() const
         {
             return _groundObjectPart;
         }
 
-        std::list<ObjectPart> & getGroundObjectParts()
+        std::vector<ObjectPart> & getGroundObjectParts()
         {
             return _groundObjectPart;
         }
 
-        const std::list<ObjectPart> & getTopObjectParts() const
+        const std::vector<ObjectPart> & getTopObjectParts() const
         {
             return _topObjectPart;
         }
@@ -393,9 +392,9 @@ namespace Maps
 
         ObjectPart _mainObjectPart;
 
-        std::list<ObjectPart> _groundObjectPart;
+        std::vector<ObjectPart> _groundObjectPart;
 
-        std::list<ObjectPart> _topObjectPart;
+        std::vector<ObjectPart> _topObjectPart;
 
         int32_t _index{ 0 };
 
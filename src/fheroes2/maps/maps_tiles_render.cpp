@@ -984,6 +984,65 @@ namespace Maps
         }
     }
 
+    bool redrawTerrainWithStaticObjects( const Tile & tile, fheroes2::Image & dst, const fheroes2::Point & offset )
+    {
+        const fheroes2::Image & terrainImage = getTileSurface( tile );
+        fheroes2::Copy( terrainImage, 0, 0, dst, offset.x, offset.y, terrainImage.width(), terrainImage.height() );
+
+        const auto isStaticPart = []( const ObjectPart & part ) {
+            if ( part.icnType == MP2::OBJ_ICN_TYPE_FLAG32 ) {
+                // Flags must be rendered after the main object and they do not always fit into a tile.
+                return false;
+            }
+
+            const auto * objectInfo = Maps::getObjectPartByIcn( part.icnType, part.icnIndex );
+            return objectInfo == nullptr || objectInfo->animationFrames == 0;
+        };
+
+        const ObjectPart & mainPart = tile.getMainObjectPart();
+        const bool hasMainPart = ( mainPart.icnType != MP2::OBJ_ICN_TYPE_UNKNOWN && mainPart.layerType == TERRAIN_LAYER );
+        if ( hasMainPart && !isStaticPart( mainPart ) ) {
+            return false;
+        }
+
+        const auto & groundParts = tile.getGroundObjectParts();
+        for ( const auto & part : groundParts ) {
+            if ( part.layerType == TERRAIN_LAYER && !isStaticPart( part ) ) {
+                return false;
+            }
+        }
+
+        const auto renderPart = [&dst, &offset]( const int icn, const ObjectPart & part ) {
+            const fheroes2::Sprite & sprite = Assets::getImage( icn, part.icnIndex );
+
+            // If this assertion blows up we are trying to render an image bigger than a tile.
+            assert( sprite.x() >= 0 && sprite.width() + sprite.x() <= fheroes2::tileWidthPx && sprite.y() >= 0 && sprite.height() + sprite.y() <= fheroes2::tileWidthPx );
+
+            fheroes2::Blit( sprite, dst, offset.x + sprite.x(), offset.y + sprite.y() );
+        };
+
+        // The order of rendering must be the same as in redrawBottomLayerObjects() function.
+        for ( const auto & part : groundParts ) {
+            if ( part.layerType != TERRAIN_LAYER ) {
+                continue;
+            }
+
+            const int icn = MP2::getIcnIdFromObjectIcnType( part.icnType );
+            if ( !isObjectPartDirectRenderingRestricted( icn ) ) {
+                renderPart( icn, part );
+            }
+        }
+
+        if ( hasMainPart ) {
+            const int icn = MP2::getIcnIdFromObjectIcnType( mainPart.icnType );
+            if ( !isTileDirectRenderingRestricted( icn, tile.getMainObjectType() ) ) {
+                renderPart( icn, mainPart );
+            }
+        }
+
+        return true;
+    }
+
     void drawByObjectIcnType( const Tile & tile, fheroes2::Image & output, const Interface::GameArea & area, const MP2::ObjectIcnType objectIcnType )
     {
         const fheroes2::Point & tileOffset = Maps::GetPoint( tile.GetIndex() );
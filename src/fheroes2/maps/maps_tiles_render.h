@@ -61,6 +61,10 @@ namespace Maps
 
     void redrawBottomLayerObjects( const Tile & tile, fheroes2::Image & dst, bool isPuzzleDraw, const Interface::GameArea & area, const uint8_t level );
 
+    // Renders the terrain image of the tile at the given position of the image. Terrain layer object parts (roads, rivers, cracks) are rendered as well
+    // if they never change their look. Returns false if these object parts are not rendered so they must be rendered separately.
+    bool redrawTerrainWithStaticObjects( const Tile & tile, fheroes2::Image & dst, const fheroes2::Point & offset );
+
     void drawByObjectIcnType( const Tile & tile, fheroes2::Image & output, const Interface::GameArea & area, const MP2::ObjectIcnType objectIcnType );
 
     std::vector<fheroes2::ObjectRenderingInfo> getMonsterSpritesPerTile( const Tile & tile, const bool isEditorMode );
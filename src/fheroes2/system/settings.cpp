@@ -129,6 +129,9 @@ Settings::Settings()
 
         // Smooth scrolling (inertia) feels natural on touch devices and is enabled by default.
         _isMapSmoothScrollingEnabled = true;
+
+        // Handheld devices usually have little memory so do not keep images which have not been used for a long time.
+        _imageCacheLimit = 128;
     }
 
     // The Price of Loyalty is not supported by default.
@@ -312,6 +315,14 @@ bool Settings::Read( const std::string & filePath )
         _controllerPointerSpeed = std::clamp( config.IntParams( "controller pointer speed" ), 0, 100 );
     }
 
+    if ( config.Exists( "image cache limit" ) ) {
+        _imageCacheLimit = std::max( config.IntParams( "image cache limit" ), 0 );
+    }
+
+    if ( config.Exists( "editor history memory limit" ) ) {
+        _editorHistoryMemoryLimit = std::max( config.IntParams( "editor history memory limit" ), 0 );
+    }
+
     if ( config.Exists( "first time game run" ) && config.StrParams( "first time game run" ) == "off" ) {
         resetFirstGameRun();
     }
@@ -378,6 +389,10 @@ bool Settings::Read( const std::string & filePath )
         }
     }
 
+    if ( config.Exists( "save file compression" ) ) {
+        _isFastSaveCompressionEnabled = ( config.StrParams( "save file compression" ) == "fast" );
+    }
+
     return true;
 }
 
@@ -532,6 +547,12 @@ std::string Settings::getOptionsString() const
     os << std::endl << "# Controller pointer speed: 0 - 100" << std::endl;
     os << "controller pointer speed = " << _controllerPointerSpeed << std::endl;
 
+    os << std::endl << "# Memory limit in megabytes for images which can be reloaded when needed: 0 means no limit" << std::endl;
+    os << "image cache limit = " << _imageCacheLimit << std::endl;
+
+    os << std::endl << "# Memory limit in megabytes for the Editor's undo history: 0 means no limit" << std::endl;
+    os << "editor history memory limit = " << _editorHistoryMemoryLimit << std::endl;
+
     os << std::endl << "# First time game run (show additional hints): on/off" << std::endl;
     os << "first time game run = " << ( _gameOptions.Modes( GAME_FIRST_RUN ) ? "on" : "off" ) << std::endl;
 
@@ -568,6 +589,9 @@ std::string Settings::getOptionsString() const
     os << std::endl << "# Save files sorting method: name/date" << std::endl;
     os << "save file sorting = " << ( _saveFileSortType == SaveFileSortingMethod::TIMESTAMP ? "date" : "name" ) << std::endl;
 
+    os << std::endl << "# Save file compression: 'zlib' (smaller files) or 'fast' (faster saving, larger files)" << std::endl;
+    os << "save file compression = " << ( _isFastSaveCompressionEnabled ? "fast" : "zlib" ) << std::endl;
+
     os << std::endl << "# Show army size estimates: in 'canonical' (few, several, lots, ...) or 'numeric' (1-4, 5-9, 10-19, ...) way" << std::endl;
     os << "army estimation view type = " << ( _gameOptions.Modes( GAME_NUMERIC_ARMY_ESTIMATION_VIEW ) ? "numeric" : "canonical" ) << std::endl;
 
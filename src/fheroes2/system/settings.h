@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <string_view>
@@ -382,6 +383,12 @@ public:
         return _controllerPointerSpeed;
     }
 
+    // Returns the memory limit for images which can be reloaded in bytes. 0 means no limit.
+    size_t imageCacheLimit() const
+    {
+        return static_cast<size_t>( _imageCacheLimit ) * 1024 * 1024;
+    }
+
     ZoomLevel ViewWorldZoomLevel() const
     {
         return _viewWorldZoomLevel;
@@ -414,6 +421,18 @@ public:
         _saveFileSortType = sortType;
     }
 
+    // Returns the memory limit for the Editor's undo history in bytes. 0 means no limit.
+    size_t editorHistoryMemoryLimit() const
+    {
+        return static_cast<size_t>( _editorHistoryMemoryLimit ) * 1024 * 1024;
+    }
+
+    // Returns true if saved games should be zipped by the fast LZ codec instead of zlib.
+    bool isFastSaveCompressionEnabled() const
+    {
+        return _isFastSaveCompressionEnabled;
+    }
+
     void SetProgramPath( const char * path );
 
     static const std::vector<std::string> & GetRootDirs();
@@ -455,6 +474,9 @@ private:
     int music_volume;
     MusicSource _musicType;
     int _controllerPointerSpeed;
+    int _imageCacheLimit{ 0 };
+    int _editorHistoryMemoryLimit{ 64 };
+    bool _isFastSaveCompressionEnabled{ false };
     int heroes_speed;
     int ai_speed;
     int scroll_speed;
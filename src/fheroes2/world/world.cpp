@@ -1189,6 +1189,8 @@ void World::updatePassabilities()
     for ( Maps::Tile & tile : vec_tiles ) {
         tile.updatePassability();
     }
+
+    _portalGraph.invalidateAll();
 }
 
 void World::PostLoad( const bool setTilePassabilities, const bool updateUidCounterToMaximum )
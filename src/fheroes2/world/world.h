@@ -485,6 +485,11 @@ public:
     const MapRegion & getRegion( size_t id ) const;
     size_t getRegionCount() const;
 
+    RegionPortalGraph & getPortalGraph()
+    {
+        return _portalGraph;
+    }
+
     uint8_t getWaterPercentage() const
     {
         return _waterPercentage;
@@ -583,6 +588,7 @@ private:
     uint8_t _waterPercentage{ 0 };
     double _landRoughness{ 1.0 };
     std::vector<MapRegion> _regions;
+    RegionPortalGraph _portalGraph;
     PlayerWorldPathfinder _pathfinder;
 };
 
@@ -39,6 +39,7 @@
 #include "ground.h"
 #include "heroes.h"
 #include "kingdom.h"
+#include "logging.h"
 #include "maps.h"
 #include "maps_tiles.h"
 #include "maps_tiles_helper.h"
@@ -386,6 +387,62 @@ void WorldPathfinder::reset()
     _color = PlayerColor::NONE;
     _remainingMovePoints = 0;
     _pathfindingSkill = Skill::Level::EXPERT;
+    _costLimit = UINT32_MAX;
+}
+
+void WorldNodeQueue::push( const uint32_t cost, const int nodeIdx )
+{
+    assert( cost >= _lastCost );
+
+    _buckets[_getBucketIndex( cost )].emplace_back( cost, nodeIdx );
+    ++_size;
+}
+
+std::pair<uint32_t, int> WorldNodeQueue::pop()
+{
+    assert( _size > 0 );
+
+    if ( _buckets[0].empty() ) {
+        size_t bucketIdx = 1;
+        while ( _buckets[bucketIdx].empty() ) {
+            ++bucketIdx;
+
+            assert( bucketIdx < _buckets.size() );
+        }
+
+        std::vector<std::pair<uint32_t, int>> & bucket = _buckets[bucketIdx];
+
+        _lastCost = std::min_element( bucket.begin(), bucket.end() )->first;
+
+        // All the items of this bucket are moved to the buckets with lower indexes, at least one of them to the first bucket.
+        for ( const auto & item : bucket ) {
+            _buckets[_getBucketIndex( item.first )].push_back( item );
+        }
+
+        bucket.clear();
+    }
+
+    std::vector<std::pair<uint32_t, int>> & bucket = _buckets[0];
+    assert( !bucket.empty() );
+
+    const std::pair<uint32_t, int> item = bucket.back();
+    bucket.pop_back();
+
+    --_size;
+
+    return item;
+}
+
+size_t WorldNodeQueue::_getBucketIndex( const uint32_t cost ) const
+{
+    // The index of the highest differing bit plus one, or zero if there are no differing bits.
+    size_t bucketIdx = 0;
+
+    for ( uint32_t diff = cost ^ _lastCost; diff != 0; diff >>= 1 ) {
+        ++bucketIdx;
+    }
+
+    return bucketIdx;
 }
 
 void WorldPathfinder::processWorldMap()
@@ -398,15 +455,44 @@ void WorldPathfinder::processWorldMap()
 
     _cache[_pathStart].update( -1, 0, _remainingMovePoints );
 
-    std::vector<int> nodesToExplore;
-    nodesToExplore.push_back( _pathStart );
+    WorldNodeQueue nodesToExplore;
+    nodesToExplore.push( 0, _pathStart );
+
+    exploreNodes( nodesToExplore );
+}
+
+void WorldPathfinder::exploreNodes( WorldNodeQueue & nodesToExplore )
+{
+#ifdef WITH_DEBUG
+    size_t processedNodesCount = 0;
+#endif
+
+    while ( !nodesToExplore.empty() ) {
+        const auto [cost, nodeIdx] = nodesToExplore.pop();
+
+        // All the remaining nodes are beyond the limit as well.
+        if ( cost > _costLimit ) {
+            break;
+        }
+
+        const WorldNode & node = _cache[nodeIdx];
 
-    for ( size_t lastProcessedNode = 0; lastProcessedNode < nodesToExplore.size(); ++lastProcessedNode ) {
-        processCurrentNode( nodesToExplore, nodesToExplore[lastProcessedNode] );
+        // The node was queued several times and has been already processed with a lower cost, or it was reset after being queued.
+        if ( node._cost != cost || ( node._from == -1 && nodeIdx != _pathStart ) ) {
+            continue;
+        }
+
+#ifdef WITH_DEBUG
+        ++processedNodesCount;
+#endif
+
+        processCurrentNode( nodesToExplore, nodeIdx );
     }
+
+    DEBUG_LOG( DBG_GAME, DBG_TRACE, "start: " << _pathStart << ", processed nodes: " << processedNodesCount )
 }
 
-void WorldPathfinder::checkAdjacentNodes( std::vector<int> & nodesToExplore, const int currentNodeIdx )
+void WorldPathfinder::checkAdjacentNodes( WorldNodeQueue & nodesToExplore, const int currentNodeIdx )
 {
     const auto & directions = Direction::allNeighboringDirections;
     const WorldNode & currentNode = _cache[currentNodeIdx];
@@ -430,7 +516,7 @@ void WorldPathfinder::checkAdjacentNodes( std::vector<int> & nodesToExplore, con
         if ( newNode._from == -1 || newNode._cost > movementCost ) {
             newNode.update( currentNodeIdx, movementCost, subtractMovePoints( currentNode._remainingMovePoints, movementPenalty, maxMovePoints ) );
 
-            nodesToExplore.push_back( newIndex );
+            nodesToExplore.push( movementCost, newIndex );
         }
     }
 }
@@ -497,7 +583,7 @@ std::list<Route::Step> PlayerWorldPathfinder::buildPath( const int targetIndex )
     return path;
 }
 
-void PlayerWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx )
+void PlayerWorldPathfinder::processCurrentNode( WorldNodeQueue & nodesToExplore, const int currentNodeIdx )
 {
     const bool isFirstNode = ( currentNodeIdx == _pathStart );
     const WorldNode & currentNode = _cache[currentNodeIdx];
@@ -627,16 +713,17 @@ void AIWorldPathfinder::reEvaluateIfNeeded( const Heroes & hero )
         return result;
     }();
 
+    // The whole map is always explored for heroes
     auto currentSettings
         = std::tie( _pathStart, _color, _remainingMovePoints, _pathfindingSkill, _patrolCenter, _patrolDistance, _maxMovePointsOnLand, _maxMovePointsOnWater,
                     _remainingSpellPoints, _maxSpellPoints, _dimensionDoorSPCost, _dimensionDoorNumOfUses, _armyStrength, _isOnPatrol, _isArtifactsBagFull,
-                    _isEquippedWithSpellBook, _isSummonBoatSpellAvailable, _isDimensionDoorSpellAvailable, _townGateCastleIndex, _townPortalCastleIndexes );
+                    _isEquippedWithSpellBook, _isSummonBoatSpellAvailable, _isDimensionDoorSpellAvailable, _townGateCastleIndex, _townPortalCastleIndexes, _costLimit );
     const auto newSettings
         = std::make_tuple( hero.GetIndex(), hero.GetColor(), hero.GetMovePoints(), static_cast<uint8_t>( hero.GetLevelSkill( Skill::Secondary::PATHFINDING ) ),
                            Maps::GetIndexFromAbsPoint( hero.GetPatrolCenter() ), hero.GetPatrolDistance(), hero.GetMaxMovePoints( false ), hero.GetMaxMovePoints( true ),
                            hero.GetSpellPoints(), hero.GetMaxSpellPoints(), dimensionDoor.spellPoints( &hero ), hero.getDimensionDoorUses(), hero.GetArmy().GetStrength(),
                            hero.Modes( Heroes::PATROL ), hero.IsFullBagArtifacts(), hero.HaveSpellBook(), isSummonBoatSpellAvailable, isDimensionDoorSpellAvailable,
-                           townGateCastleIndex, townPortalCastleIndexes );
+                           townGateCastleIndex, townPortalCastleIndexes, UINT32_MAX );
 
     if ( currentSettings != newSettings ) {
         currentSettings = newSettings;
@@ -645,7 +732,8 @@ void AIWorldPathfinder::reEvaluateIfNeeded( const Heroes & hero )
     }
 }
 
-void AIWorldPathfinder::reEvaluateIfNeeded( const int start, const PlayerColor color, const double armyStrength, const uint8_t skill )
+void AIWorldPathfinder::reEvaluateIfNeeded( const int start, const PlayerColor color, const double armyStrength, const uint8_t skill,
+                                            const uint32_t costLimit /* = UINT32_MAX */ )
 {
     auto currentSettings
         = std::tie( _pathStart, _color, _remainingMovePoints, _pathfindingSkill, _patrolCenter, _patrolDistance, _maxMovePointsOnLand, _maxMovePointsOnWater,
@@ -654,8 +742,10 @@ void AIWorldPathfinder::reEvaluateIfNeeded( const int start, const PlayerColor c
     const auto newSettings
         = std::make_tuple( start, color, 0U, skill, -1, 0U, 0U, 0U, 0U, 0U, 0U, 0U, armyStrength, false, false, false, false, false, -1, std::vector<int32_t>{} );
 
-    if ( currentSettings != newSettings ) {
+    // The cache built with a higher cost limit is still valid for a lower one
+    if ( currentSettings != newSettings || _costLimit < costLimit ) {
         currentSettings = newSettings;
+        _costLimit = costLimit;
 
         processWorldMap();
     }
@@ -693,8 +783,8 @@ void AIWorldPathfinder::processWorldMap()
 
     _cache[_pathStart].update( -1, 0, _remainingMovePoints );
 
-    std::vector<int> nodesToExplore;
-    nodesToExplore.push_back( _pathStart );
+    WorldNodeQueue nodesToExplore;
+    nodesToExplore.push( 0, _pathStart );
 
     const auto processTownPortal = [this, &nodesToExplore]( const Spell & spell, const int32_t castleIndex ) {
         assert( castleIndex >= 0 && static_cast<size_t>( castleIndex ) < _cache.size() );
@@ -705,7 +795,7 @@ void AIWorldPathfinder::processWorldMap()
 
         _cache[castleIndex].update( _pathStart, cost, remaining );
 
-        nodesToExplore.push_back( castleIndex );
+        nodesToExplore.push( cost, castleIndex );
     };
 
     if ( _townGateCastleIndex != -1 ) {
@@ -720,9 +810,7 @@ void AIWorldPathfinder::processWorldMap()
         processTownPortal( Spell::TOWNPORTAL, idx );
     }
 
-    for ( size_t lastProcessedNode = 0; lastProcessedNode < nodesToExplore.size(); ++lastProcessedNode ) {
-        processCurrentNode( nodesToExplore, nodesToExplore[lastProcessedNode] );
-    }
+    exploreNodes( nodesToExplore );
 }
 
 bool AIWorldPathfinder::isMovementAllowed( const int from, const int direction ) const
@@ -730,7 +818,7 @@ bool AIWorldPathfinder::isMovementAllowed( const int from, const int direction )
     return isMovementAllowedForColor( from, direction, _color, false, _isSummonBoatSpellAvailable );
 }
 
-void AIWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx )
+void AIWorldPathfinder::processCurrentNode( WorldNodeQueue & nodesToExplore, const int currentNodeIdx )
 {
     const bool isFirstNode = ( currentNodeIdx == _pathStart );
     WorldNode & currentNode = _cache[currentNodeIdx];
@@ -792,7 +880,7 @@ void AIWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, c
             if ( teleportNode._from == -1 || teleportNode._cost > currentNode._cost ) {
                 teleportNode.update( currentNodeIdx, currentNode._cost, currentNode._remainingMovePoints );
 
-                nodesToExplore.push_back( teleportIdx );
+                nodesToExplore.push( currentNode._cost, teleportIdx );
             }
         }
 
@@ -1392,9 +1480,15 @@ std::list<Route::Step> AIWorldPathfinder::buildPath( const int targetIndex, cons
 }
 
 uint32_t AIWorldPathfinder::getDistance( const int start, const int targetIndex, const PlayerColor color, const double armyStrength,
-                                         const uint8_t skill /* = Skill::Level::EXPERT */ )
+                                         const uint8_t skill /* = Skill::Level::EXPERT */, const uint32_t distanceLimit /* = UINT32_MAX */ )
 {
-    reEvaluateIfNeeded( start, color, armyStrength, skill );
+    // There is no need to explore the map if the region portal graph shows that the target is unreachable or is beyond the limit.
+    if ( const uint32_t minimalDistance = world.getPortalGraph().getMinimalDistance( start, targetIndex, distanceLimit );
+         minimalDistance == UINT32_MAX || minimalDistance > distanceLimit ) {
+        return 0;
+    }
+
+    reEvaluateIfNeeded( start, color, armyStrength, skill, distanceLimit );
 
     assert( targetIndex >= 0 && static_cast<size_t>( targetIndex ) < _cache.size() );
 
@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <list>
 #include <optional>
@@ -71,6 +73,39 @@ struct WorldNode final
     }
 };
 
+// Priority queue of the World Map tiles to explore, ordered by the movement cost of reaching them. It is a radix heap, which
+// requires that the costs of the extracted tiles never decrease, which is always the case for the Dijkstra's algorithm.
+class WorldNodeQueue final
+{
+public:
+    WorldNodeQueue() = default;
+    WorldNodeQueue( const WorldNodeQueue & ) = delete;
+
+    ~WorldNodeQueue() = default;
+
+    WorldNodeQueue & operator=( const WorldNodeQueue & ) = delete;
+
+    bool empty() const
+    {
+        return _size == 0;
+    }
+
+    // Adds the tile with the given index. The cost must not be less than the cost of the last extracted tile.
+    void push( const uint32_t cost, const int nodeIdx );
+
+    // Extracts one of the tiles with the lowest cost. Returns a pair consisting of the cost and the tile index.
+    std::pair<uint32_t, int> pop();
+
+private:
+    // The bucket with index N contains the tiles whose cost differs from the last extracted cost in the N-th bit at most.
+    std::array<std::vector<std::pair<uint32_t, int>>, 33> _buckets;
+
+    uint32_t _lastCost{ 0 };
+    size_t _size{ 0 };
+
+    size_t _getBucketIndex( const uint32_t cost ) const;
+};
+
 // Abstract class that provides basic functionality for navigating the World Map
 class WorldPathfinder
 {
@@ -87,16 +122,21 @@ public:
     uint32_t getDistance( int targetIndex ) const;
 
 protected:
-    void checkAdjacentNodes( std::vector<int> & nodesToExplore, const int currentNodeIdx );
+    void checkAdjacentNodes( WorldNodeQueue & nodesToExplore, const int currentNodeIdx );
 
     virtual void processWorldMap();
 
+    // Processes the queued nodes in the order of their cost until the queue is empty. Since movement penalties are never
+    // negative, the cost of a node is final by the time it is extracted, so every node is processed only once unless it is
+    // reset by processCurrentNode() and then reached again.
+    void exploreNodes( WorldNodeQueue & nodesToExplore );
+
     // Checks whether moving from the source tile in the specified direction is allowed. The default implementation
     // can be overridden by a derived class.
     virtual bool isMovementAllowed( const int from, const int direction ) const;
 
     // Defines the pathfinding rules and should be implemented by a derived class.
-    virtual void processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx ) = 0;
+    virtual void processCurrentNode( WorldNodeQueue & nodesToExplore, const int currentNodeIdx ) = 0;
 
     // Returns the maximum number of movement points, depending on whether the movement is performed by land or by
     // water. Should be implemented by a derived class.
@@ -119,6 +159,10 @@ protected:
     PlayerColor _color{ PlayerColor::NONE };
     uint32_t _remainingMovePoints{ 0 };
     uint8_t _pathfindingSkill{ Skill::Level::EXPERT };
+
+    // Nodes with a cost greater than this limit are not explored, so the cost of any node that exceeds this limit
+    // may not be final, and the nodes beyond it may be not reached at all.
+    uint32_t _costLimit{ UINT32_MAX };
 };
 
 class PlayerWorldPathfinder final : public WorldPathfinder
@@ -141,7 +185,7 @@ public:
 
 private:
     // Follows regular passability rules (for the human player)
-    void processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx ) override;
+    void processCurrentNode( WorldNodeQueue & nodesToExplore, const int currentNodeIdx ) override;
 
     // Returns the maximum number of movement points. This class is not intended for planning paths passing both on
     // land and on water at the same time, so the maximum number of movement points corresponding to the type of
@@ -168,7 +212,8 @@ public:
     void reset() override;
 
     void reEvaluateIfNeeded( const Heroes & hero );
-    void reEvaluateIfNeeded( const int start, const PlayerColor color, const double armyStrength, const uint8_t skill );
+    // Nodes with a cost greater than 'costLimit' are not explored. The cache is rebuilt only if it has been built with a lower cost limit.
+    void reEvaluateIfNeeded( const int start, const PlayerColor color, const double armyStrength, const uint8_t skill, const uint32_t costLimit = UINT32_MAX );
 
     // Finds the most profitable tile for fog discovery. Returns a pair consisting of the tile index (-1 if no suitable tile
     // was found) and a boolean value, which takes the value true if there is fog next to this tile (that is, most likely,
@@ -193,8 +238,11 @@ public:
     // If the destination tile is not reachable in principle, then an empty path is returned.
     std::list<Route::Step> buildPath( const int targetIndex, const bool accountNearestObject ) const;
 
-    // Used for non-hero armies, like castles or monsters
-    uint32_t getDistance( const int start, const int targetIndex, const PlayerColor color, const double armyStrength, const uint8_t skill = Skill::Level::EXPERT );
+    // Used for non-hero armies, like castles or monsters. Only the part of the map within 'distanceLimit' from the start is explored, so
+    // if the target is farther than this limit, then either 0 or some value greater than this limit is returned. The map is not explored
+    // at all if the region portal graph shows that the target is unreachable or is farther than this limit.
+    uint32_t getDistance( const int start, const int targetIndex, const PlayerColor color, const double armyStrength, const uint8_t skill = Skill::Level::EXPERT,
+                          const uint32_t distanceLimit = UINT32_MAX );
     // Faster, but does not re-evaluate the map (exposed method of the base class)
     using WorldPathfinder::getDistance;
 
@@ -230,7 +278,7 @@ private:
     bool isMovementAllowed( const int from, const int direction ) const override;
 
     // Follows custom passability rules (for the AI)
-    void processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx ) override;
+    void processCurrentNode( WorldNodeQueue & nodesToExplore, const int currentNodeIdx ) override;
 
     // Returns the maximum number of movement points, depending on whether the movement is performed by land or by
     // water
@@ -29,12 +29,15 @@
 #include <vector>
 
 #include "castle.h"
+#include "direction.h"
 #include "ground.h"
 #include "maps.h"
 #include "maps_tiles.h"
 #include "math_base.h"
 #include "mp2.h"
+#include "skill.h"
 #include "world.h" // IWYU pragma: associated
+#include "world_pathfinding.h"
 
 namespace
 {
@@ -144,6 +147,60 @@ namespace
             }
         }
     }
+
+    // Checks whether the step from the given tile in the given direction can be made by anyone under any conditions.
+    bool isStepPossible( const int32_t from, const int direction )
+    {
+        if ( !Maps::isValidDirection( from, direction ) || !world.getTile( from ).isPassableTo( direction ) ) {
+            return false;
+        }
+
+        return world.getTile( Maps::GetDirectionIndex( from, direction ) ).isPassableFrom( Direction::Reflect( direction ) );
+    }
+
+    // Returns the cost of the step for an army with the Expert Pathfinding skill, which is the lowest possible cost of this step.
+    uint32_t getMinimalStepCost( const int32_t from, const int32_t to, const int direction )
+    {
+        const Maps::Tile & fromTile = world.getTile( from );
+
+        uint32_t penalty = fromTile.isRoad() && world.getTile( to ).isRoad() ? Maps::Ground::roadPenalty : Maps::Ground::GetPenalty( fromTile, Skill::Level::EXPERT );
+
+        // Diagonal movement costs 50% more
+        if ( Direction::isDiagonal( direction ) ) {
+            penalty = penalty * 3 / 2;
+        }
+
+        return penalty;
+    }
+
+    bool isTeleport( const int32_t tileIndex )
+    {
+        const MP2::MapObjectType objectType = world.getTile( tileIndex ).getMainObjectType( false );
+
+        return objectType == MP2::OBJ_STONE_LITHS || objectType == MP2::OBJ_WHIRLPOOL;
+    }
+
+    MapsIndexes getTeleportEndPoints( const int32_t tileIndex )
+    {
+        MapsIndexes teleports = world.GetTeleportEndPoints( tileIndex );
+        if ( teleports.empty() ) {
+            teleports = world.GetWhirlpoolEndPoints( tileIndex );
+        }
+
+        return teleports;
+    }
+
+    uint32_t getNextStamp( std::vector<uint32_t> & stamps, const uint32_t stamp )
+    {
+        if ( stamp < UINT32_MAX ) {
+            return stamp + 1;
+        }
+
+        // All the stamps have been used, start from the beginning.
+        std::fill( stamps.begin(), stamps.end(), 0 );
+
+        return 1;
+    }
 }
 
 MapRegion::MapRegion( int regionIndex, int mapIndex, bool water, size_t expectedSize )
@@ -395,4 +452,291 @@ void World::ComputeStaticAnalysis()
             _regions[adjacent]._neighbours.insert( reg._id );
         }
     }
+
+    _portalGraph.reset();
+}
+
+void RegionPortalGraph::reset()
+{
+    const size_t worldSize = world.getSize();
+
+    _tileRegions.assign( worldSize, REGION_NODE_BLOCKED );
+    _tilePortals.assign( worldSize, -1 );
+
+    _regions.clear();
+    _regions.resize( world.getRegionCount() );
+
+    _searchCosts.assign( worldSize, 0 );
+    _searchStamps.assign( worldSize, 0 );
+    _updateCosts.assign( worldSize, 0 );
+    _updateStamps.assign( worldSize, 0 );
+    _searchStamp = 0;
+    _updateStamp = 0;
+
+    for ( size_t i = 0; i < worldSize; ++i ) {
+        const uint32_t regionId = world.getTile( static_cast<int32_t>( i ) ).GetRegion();
+        if ( regionId < REGION_NODE_FOUND || regionId >= _regions.size() ) {
+            continue;
+        }
+
+        _tileRegions[i] = regionId;
+        _regions[regionId].tiles.push_back( static_cast<int32_t>( i ) );
+    }
+
+    for ( size_t i = 0; i < worldSize; ++i ) {
+        _assignRegion( static_cast<int32_t>( i ) );
+    }
+}
+
+void RegionPortalGraph::invalidateTile( const int32_t tileIndex )
+{
+    // The graph has not been built for this map yet.
+    if ( _tileRegions.size() != world.getSize() ) {
+        return;
+    }
+
+    Maps::Indexes tiles = Maps::getAroundIndexes( tileIndex );
+    tiles.push_back( tileIndex );
+
+    for ( const int32_t index : tiles ) {
+        _assignRegion( index );
+
+        if ( const uint32_t regionId = _tileRegions[index]; regionId >= REGION_NODE_FOUND ) {
+            _regions[regionId].isValid = false;
+        }
+    }
+}
+
+void RegionPortalGraph::invalidateAll()
+{
+    // The graph has not been built for this map yet.
+    if ( _tileRegions.size() != world.getSize() ) {
+        return;
+    }
+
+    for ( size_t i = 0; i < _tileRegions.size(); ++i ) {
+        _assignRegion( static_cast<int32_t>( i ) );
+    }
+
+    for ( RegionPortals & region : _regions ) {
+        region.isValid = false;
+    }
+}
+
+uint32_t RegionPortalGraph::getMinimalDistance( const int32_t start, const int32_t target, const uint32_t costLimit )
+{
+    assert( Maps::isValidAbsIndex( start ) && Maps::isValidAbsIndex( target ) );
+
+    // The graph has not been built for this map, nothing is known about the distance.
+    if ( _tileRegions.size() != world.getSize() ) {
+        return 0;
+    }
+
+    if ( start == target ) {
+        return 0;
+    }
+
+    const uint32_t startRegionId = _tileRegions[start];
+    const uint32_t targetRegionId = _tileRegions[target];
+
+    // It is impossible to leave or to enter an impassable tile.
+    if ( startRegionId < REGION_NODE_FOUND || targetRegionId < REGION_NODE_FOUND ) {
+        return UINT32_MAX;
+    }
+
+    _searchStamp = getNextStamp( _searchStamps, _searchStamp );
+
+    WorldNodeQueue nodesToExplore;
+
+    _visit( _searchCosts, _searchStamps, _searchStamp, start, 0 );
+    nodesToExplore.push( 0, start );
+
+    const auto visit = [this, &nodesToExplore]( const int32_t tileIndex, const uint32_t cost ) {
+        if ( _visit( _searchCosts, _searchStamps, _searchStamp, tileIndex, cost ) ) {
+            nodesToExplore.push( cost, tileIndex );
+        }
+    };
+
+    while ( !nodesToExplore.empty() ) {
+        const auto [cost, tileIndex] = nodesToExplore.pop();
+
+        // The tile has been already processed with a lower cost.
+        if ( _searchCosts[tileIndex] != cost ) {
+            continue;
+        }
+
+        if ( tileIndex == target || cost > costLimit ) {
+            return cost;
+        }
+
+        const uint32_t regionId = _tileRegions[tileIndex];
+        if ( regionId < REGION_NODE_FOUND ) {
+            // This is an impassable teleport endpoint, there is no way out of it.
+            continue;
+        }
+
+        // The start and the target regions are explored tile by tile, other regions are crossed using the paths between their portals.
+        const bool isExploredByTiles = ( regionId == startRegionId || regionId == targetRegionId );
+
+        for ( const int direction : Direction::allNeighboringDirections ) {
+            if ( !isStepPossible( tileIndex, direction ) ) {
+                continue;
+            }
+
+            const int32_t newIndex = Maps::GetDirectionIndex( tileIndex, direction );
+            if ( !isExploredByTiles && _tileRegions[newIndex] == regionId ) {
+                continue;
+            }
+
+            visit( newIndex, cost + getMinimalStepCost( tileIndex, newIndex, direction ) );
+        }
+
+        // Teleports cannot be used on the starting tile.
+        if ( tileIndex != start && isTeleport( tileIndex ) ) {
+            for ( const int32_t teleportIndex : getTeleportEndPoints( tileIndex ) ) {
+                visit( teleportIndex, cost );
+            }
+        }
+
+        if ( isExploredByTiles ) {
+            continue;
+        }
+
+        if ( !_regions[regionId].isValid ) {
+            _updateRegion( regionId );
+        }
+
+        // Only portals can be reached in the regions that are not explored tile by tile, unless this is an impassable teleport endpoint.
+        const int32_t portalId = _tilePortals[tileIndex];
+        if ( portalId < 0 ) {
+            continue;
+        }
+
+        for ( const auto & [portalIndex, pathCost] : _regions[regionId].portals[portalId].paths ) {
+            visit( portalIndex, cost + pathCost );
+        }
+    }
+
+    return UINT32_MAX;
+}
+
+void RegionPortalGraph::_assignRegion( const int32_t tileIndex )
+{
+    if ( _tileRegions[tileIndex] >= REGION_NODE_FOUND || world.getTile( tileIndex ).GetPassable() == 0 ) {
+        return;
+    }
+
+    // The tile has become passable after the regions were built (e.g. an object was removed from it), so it joins one of the adjacent regions.
+    // If there are no such regions, then it forms a new region.
+    uint32_t regionId = static_cast<uint32_t>( _regions.size() );
+
+    for ( const int32_t index : Maps::getAroundIndexes( tileIndex ) ) {
+        if ( _tileRegions[index] >= REGION_NODE_FOUND ) {
+            regionId = _tileRegions[index];
+            break;
+        }
+    }
+
+    if ( regionId == _regions.size() ) {
+        _regions.emplace_back();
+    }
+
+    _tileRegions[tileIndex] = regionId;
+
+    RegionPortals & region = _regions[regionId];
+    region.tiles.push_back( tileIndex );
+    region.isValid = false;
+}
+
+void RegionPortalGraph::_updateRegion( const uint32_t regionId )
+{
+    RegionPortals & region = _regions[regionId];
+
+    for ( const Portal & portal : region.portals ) {
+        _tilePortals[portal.index] = -1;
+    }
+
+    region.portals.clear();
+
+    for ( const int32_t tileIndex : region.tiles ) {
+        if ( world.getTile( tileIndex ).GetPassable() == 0 ) {
+            continue;
+        }
+
+        bool isPortal = isTeleport( tileIndex );
+
+        for ( const int direction : Direction::allNeighboringDirections ) {
+            if ( isPortal ) {
+                break;
+            }
+
+            if ( !Maps::isValidDirection( tileIndex, direction ) ) {
+                continue;
+            }
+
+            const int32_t newIndex = Maps::GetDirectionIndex( tileIndex, direction );
+            if ( _tileRegions[newIndex] == regionId ) {
+                continue;
+            }
+
+            isPortal = isStepPossible( tileIndex, direction ) || isStepPossible( newIndex, Direction::Reflect( direction ) );
+        }
+
+        if ( isPortal ) {
+            _tilePortals[tileIndex] = static_cast<int32_t>( region.portals.size() );
+            region.portals.emplace_back().index = tileIndex;
+        }
+    }
+
+    // Find the paths from every portal to the other portals that do not leave the region.
+    for ( Portal & portal : region.portals ) {
+        _updateStamp = getNextStamp( _updateStamps, _updateStamp );
+
+        WorldNodeQueue nodesToExplore;
+
+        _visit( _updateCosts, _updateStamps, _updateStamp, portal.index, 0 );
+        nodesToExplore.push( 0, portal.index );
+
+        while ( !nodesToExplore.empty() ) {
+            const auto [cost, tileIndex] = nodesToExplore.pop();
+
+            if ( _updateCosts[tileIndex] != cost ) {
+                continue;
+            }
+
+            if ( tileIndex != portal.index && _tilePortals[tileIndex] >= 0 ) {
+                portal.paths.emplace_back( tileIndex, cost );
+            }
+
+            for ( const int direction : Direction::allNeighboringDirections ) {
+                if ( !isStepPossible( tileIndex, direction ) ) {
+                    continue;
+                }
+
+                const int32_t newIndex = Maps::GetDirectionIndex( tileIndex, direction );
+                if ( _tileRegions[newIndex] != regionId ) {
+                    continue;
+                }
+
+                const uint32_t newCost = cost + getMinimalStepCost( tileIndex, newIndex, direction );
+                if ( _visit( _updateCosts, _updateStamps, _updateStamp, newIndex, newCost ) ) {
+                    nodesToExplore.push( newCost, newIndex );
+                }
+            }
+        }
+    }
+
+    region.isValid = true;
+}
+
+bool RegionPortalGraph::_visit( std::vector<uint32_t> & costs, std::vector<uint32_t> & stamps, const uint32_t stamp, const int32_t tileIndex, const uint32_t cost )
+{
+    if ( stamps[tileIndex] == stamp && costs[tileIndex] <= cost ) {
+        return false;
+    }
+
+    stamps[tileIndex] = stamp;
+    costs[tileIndex] = cost;
+
+    return true;
 }
@@ -23,6 +23,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <set>
+#include <utility>
 #include <vector>
 
 enum
@@ -63,3 +64,67 @@ public:
 
     size_t getNeighboursCount() const;
 };
+
+// Abstract graph built on top of the map regions, used to quickly find the lower bound of the movement cost between two tiles without
+// exploring the whole map. Its nodes are portals: tiles that are connected to a tile of another region, and teleports. Objects, fog and
+// the surface type are not taken into account and every step costs as much as for an army with the Expert Pathfinding skill, so the
+// found cost never exceeds the one found by the pathfinder. The paths between the portals of a region are calculated only when they
+// are needed for the first time, and they are recalculated only for the regions in which the passability of tiles has been changed.
+class RegionPortalGraph
+{
+public:
+    RegionPortalGraph() = default;
+    RegionPortalGraph( const RegionPortalGraph & ) = delete;
+
+    ~RegionPortalGraph() = default;
+
+    RegionPortalGraph & operator=( const RegionPortalGraph & ) = delete;
+
+    // Builds the graph using the regions of the current map tiles.
+    void reset();
+
+    // Marks the regions of the given tile and of the tiles around it as outdated. Should be called every time the passability of the tile is changed.
+    void invalidateTile( const int32_t tileIndex );
+
+    // Marks all the regions as outdated.
+    void invalidateAll();
+
+    // Returns the lower bound of the movement cost between the given tiles. If this cost is greater than 'costLimit', then some value greater
+    // than this limit is returned. If the target tile cannot be reached at all, UINT32_MAX is returned.
+    uint32_t getMinimalDistance( const int32_t start, const int32_t target, const uint32_t costLimit );
+
+private:
+    struct Portal
+    {
+        int32_t index{ -1 };
+        // Indexes of other portals of the same region and the costs of the paths to them within the region.
+        std::vector<std::pair<int32_t, uint32_t>> paths;
+    };
+
+    struct RegionPortals
+    {
+        std::vector<int32_t> tiles;
+        std::vector<Portal> portals;
+        bool isValid{ false };
+    };
+
+    void _assignRegion( const int32_t tileIndex );
+    void _updateRegion( const uint32_t regionId );
+
+    // Visits a tile for the search that is currently performed using the given cost and stamp arrays. Returns true if the tile was not visited
+    // before or was visited with a higher cost.
+    static bool _visit( std::vector<uint32_t> & costs, std::vector<uint32_t> & stamps, const uint32_t stamp, const int32_t tileIndex, const uint32_t cost );
+
+    std::vector<uint32_t> _tileRegions;
+    std::vector<int32_t> _tilePortals;
+    std::vector<RegionPortals> _regions;
+
+    // Costs and stamps used by the searches. A cost is valid only if its stamp matches the stamp of the current search, so they don't have to
+    // be reset before every search. The region updates are performed during the searches, so they have their own arrays.
+    std::vector<uint32_t> _searchCosts;
+    std::vector<uint32_t> _searchStamps;
+    std::vector<uint32_t> _updateCosts;
+    std::vector<uint32_t> _updateStamps;
+    uint32_t _searchStamp{ 0 };
+    uint32_t _updateStamp{ 0 };
+};